@@ -7,17 +7,45 @@
 #include <ctime>
 #include <algorithm>
 #include <sstream>
+#include <cstdint>
+#include <climits>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <queue>
+#include <functional>
+#include <set>
+#include <chrono>
+#include <random>
 
 #ifdef _WIN32
 #include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
 #endif
 
 using namespace std;
 
 const int MAX_WEIGHT = 2000;
 const string DATA_FILE = "truck_data.txt";
+const string REPLAY_PREFIX = "replay_";
 const string REPORT_FILE = "truck_report.txt";
 const string CSV_FILE = "truck_export.csv";
+const string CSV_CHANGES_FILE = "truck_export_changes.csv";
+const string CSV_WATERMARK_FILE = "truck_export.watermark";
+const string CSV_STATE_FILE = "truck_export.state";
+const string DELTA_REPORT_FILE = "truck_report_delta.txt";
+const string COLUMNAR_FILE = "truck_export.twc";
+const string COLUMNAR_MAGIC = "TWMSCOL1";
+const size_t ROW_GROUP_SIZE = 65536;
+const int LOAD_PRIORITY_SECONDS = 60;
+const double DELTA_FULL_RATIO = 0.5;
+const size_t STATE_RECORD_WIDTH = 17;
+const string ANSI_CLEAR = "\033[H\033[2J\033[3J";
 
 struct Box {
     int weight;
@@ -38,15 +66,16 @@ struct Truck {
     string timestamp;
     string destination;
     string status;
+    int serial;  // session-wide id that survives renumbering; not saved
 
     Truck() : truckNumber(0), emptyWeight(0), totalWeight(0),
               isOverloaded(false), driverName(""), licensePlate(""),
-              destination(""), status("Pending") {}
+              destination(""), status("Pending"), serial(0) {}
 
     Truck(int num, int weight, string driver, string plate, string dest)
         : truckNumber(num), emptyWeight(weight), totalWeight(0),
           isOverloaded(false), driverName(driver), licensePlate(plate),
-          destination(dest), status("Pending") {
+          destination(dest), status("Pending"), serial(0) {
         timestamp = getCurrentTimestamp();
     }
 
@@ -101,107 +130,422 @@ struct Statistics {
                    maxWeight(0), minWeight(0), averageLoadPercentage(0) {}
 };
 
-void displayHeader();
+// BK-tree over normalized keys; each node holds the serial of every truck
+// sharing that key. Removed trucks leave their node behind for routing.
+struct BKNode {
+    string key;
+    vector<int> serials;
+    vector<pair<int, int>> children;  // (edit distance, node index)
+
+    BKNode(const string& k, int serial) : key(k), serials(1, serial) {}
+};
+
+struct BKTree {
+    vector<BKNode> nodes;
+
+    void insert(const string& key, int serial);
+    void remove(const string& key, int serial);
+    void query(const string& key, int maxDistance, vector<pair<int, int>>& matches) const;
+};
+
+// One searchable field, keyed by truck serial so deletes and sorts leave it
+// valid. Postings of every 2- and 3-byte gram (ascending serials) serve
+// substring matches and narrow fuzzy candidates.
+struct FieldIndex {
+    BKTree tree;
+    vector<string> keys;
+    unordered_map<string, vector<int>> grams;
+};
+
+// Built when the fleet is loaded, then kept in step by add and delete.
+struct SearchIndex {
+    FieldIndex drivers;
+    FieldIndex plates;
+};
+
+enum RollupGranularity { ROLLUP_HOUR, ROLLUP_DAY, ROLLUP_WEEK };
+
+struct RollupCell {
+    int trucks;
+    long long tonnage;
+
+    RollupCell() : trucks(0), tonnage(0) {}
+};
+
+// (time bucket, destination, status) -> aggregate, one cube per granularity.
+// Kept in step with every add, status change and delete so reports never
+// have to scan the fleet.
+typedef tuple<string, string, string> RollupKey;
+
+struct RollupStore {
+    map<RollupKey, RollupCell> cubes[3];
+};
+
+struct RollupRow {
+    string bucket;
+    string group;
+    RollupCell cell;
+};
+
+enum ColumnType { COL_INT32, COL_TIMESTAMP, COL_STRING };
+enum ColumnEncoding { ENC_PLAIN, ENC_DELTA, ENC_DICTIONARY };
+
+struct ColumnSpec {
+    string name;
+    ColumnType type;
+    ColumnEncoding encoding;
+};
+
+struct ColumnStats {
+    long long minValue;
+    long long maxValue;
+    string minString;
+    string maxString;
+    size_t distinct;
+    size_t bytes;
+
+    ColumnStats() : minValue(0), maxValue(0), distinct(0), bytes(0) {}
+};
+
+struct ColumnBuffer {
+    ColumnSpec spec;
+    vector<long long> ints;
+    vector<string> strings;
+};
+
+struct RowGroupMeta {
+    int table;
+    size_t offset;
+    size_t rows;
+    vector<ColumnStats> stats;
+};
+
+struct ColumnarTable {
+    string name;
+    vector<ColumnBuffer> columns;
+    size_t rows;
+};
+
+// Streams tables to a Parquet-style file: row groups of at most
+// ROW_GROUP_SIZE rows are encoded and written as soon as they fill, and the
+// schema plus per-column statistics (min, max, exact distinct count and
+// encoded size for every column of every row group) go into a footer.
+struct ColumnarWriter {
+    ofstream out;
+    vector<ColumnarTable> tables;
+    vector<RowGroupMeta> rowGroups;
+
+    bool open(const string& path);
+    int addTable(const string& name, const vector<ColumnSpec>& columns);
+    void appendInt(int table, int column, long long value) { tables[table].columns[column].ints.push_back(value); }
+    void appendString(int table, int column, const string& value) { tables[table].columns[column].strings.push_back(value); }
+    void endRow(int table);
+    void flushRowGroup(int table);
+    bool close();
+};
+
+// Keyed by truck serial, so deletes and sorts leave queued entries valid.
+struct DispatchEntry {
+    long long priority;
+    int serial;
+
+    DispatchEntry(long long p, int s) : priority(p), serial(s) {}
+
+    bool operator>(const DispatchEntry& other) const {
+        if (priority != other.priority) return priority > other.priority;
+        return serial > other.serial;
+    }
+};
+
+typedef priority_queue<DispatchEntry, vector<DispatchEntry>, greater<DispatchEntry>> DispatchQueue;
+
+// One min-heap per destination holding Ready and Near Limit trucks; lower
+// priority values leave first. Entries whose truck has since changed
+// status or been deleted are dropped lazily when they reach the top.
+// Overloaded trucks are never queued, only counted as held.
+struct DispatchScheduler {
+    map<string, DispatchQueue> queues;
+    map<string, int> waiting;
+    map<string, int> held;
+};
+
+// Truck numbers touched since one consumer last caught up. Deletes and
+// sorts renumber trucks, so they mark every position from shiftedFrom up
+// to highWater as a range instead of one entry each; numbers beyond the
+// current fleet size were removed. Nothing is kept until the consumer has
+// a baseline, and the set never holds more than highWater numbers however
+// long the consumer lags.
+struct ChangeSet {
+    bool baseline;
+    set<int> numbers;
+    int shiftedFrom;
+    int highWater;
+
+    ChangeSet() : baseline(false), shiftedFrom(INT_MAX), highWater(0) {}
+};
+
+// The CSV export and the text report each track their own changes, so
+// one running often does not make the other's backlog grow.
+struct ChangeLog {
+    ChangeSet csv;
+    ChangeSet report;
+};
+
+enum SearchField { SEARCH_DRIVER, SEARCH_PLATE, SEARCH_DESTINATION, SEARCH_STATUS };
+
+const string SEARCH_FIELD_NAMES[] = { "driver", "plate", "destination", "status" };
+const string ROLLUP_GRANULARITY_NAMES[] = { "hour", "day", "week" };
+const string MANUAL_STATUSES[] = { "Pending", "In Transit", "Delivered", "Cancelled" };
+
+// Every file a session writes. Replays prefix each name with REPLAY_PREFIX
+// so they never touch the operator's data, exports or watermark.
+struct OutputFiles {
+    string data;
+    string report;
+    string deltaReport;
+    string csv;
+    string csvChanges;
+    string csvWatermark;
+    string csvState;
+    string columnar;
+
+    OutputFiles(const string& prefix = "")
+        : data(prefix + DATA_FILE), report(prefix + REPORT_FILE), deltaReport(prefix + DELTA_REPORT_FILE),
+          csv(prefix + CSV_FILE), csvChanges(prefix + CSV_CHANGES_FILE),
+          csvWatermark(prefix + CSV_WATERMARK_FILE), csvState(prefix + CSV_STATE_FILE),
+          columnar(prefix + COLUMNAR_FILE) {}
+};
+
+// Everything a session works on. Menus and the replay harness both go
+// through the cmd* functions, which keep every index in step and append
+// each command to the journal when one is attached (--record).
+struct Fleet {
+    vector<Truck> trucks;
+    vector<int> slots;  // serial -> index into trucks, -1 once deleted
+    SearchIndex searchIndex;
+    RollupStore rollups;
+    DispatchScheduler dispatch;
+    ChangeLog changes;
+    OutputFiles files;
+    ostream* journal;
+
+    Fleet() : journal(NULL) {}
+};
+
+struct NullBuffer : streambuf {
+    int overflow(int c) { return c; }
+};
+
+void displayHeader(ostream& out = cout);
 void displayMainMenu();
 void displayReportsMenu();
 void displaySearchMenu();
-void addTrucks(vector<Truck>& trucks);
-void viewAllTrucks(const vector<Truck>& trucks);
-void viewDetailedTruckInfo(const vector<Truck>& trucks);
-void searchTrucks(const vector<Truck>& trucks);
-void searchByDriver(const vector<Truck>& trucks);
-void searchByPlate(const vector<Truck>& trucks);
-void searchByDestination(const vector<Truck>& trucks);
-void searchByStatus(const vector<Truck>& trucks);
-void updateTruckStatus(vector<Truck>& trucks);
-void deleteTruck(vector<Truck>& trucks);
-void sortTrucks(vector<Truck>& trucks);
+void displayExportMenu();
+void addTrucks(Fleet& fleet);
+int viewAllTrucks(Fleet& fleet, const string& message = "", bool selecting = false);
+int pickTruck(Fleet& fleet, const string& action);
+string composeTruckPage(const vector<Truck>& trucks, size_t page, size_t pageSize,
+                        const string& message, bool selecting);
+void renderTruckRows(ostream& out, const vector<Truck>& trucks, size_t first, size_t last);
+void viewDetailedTruckInfo(Fleet& fleet);
+void searchTrucks(Fleet& fleet);
+void searchByDriver(Fleet& fleet);
+void searchByPlate(Fleet& fleet);
+void rebuildSearchIndex(const vector<Truck>& trucks, SearchIndex& index);
+void addToSearchIndex(SearchIndex& index, const Truck& truck);
+void removeFromSearchIndex(SearchIndex& index, const Truck& truck);
+void indexKey(FieldIndex& field, int serial, const string& key);
+void unindexKey(FieldIndex& field, int serial);
+vector<string> keyGrams(const string& key);
+const vector<int>& shortestPosting(const FieldIndex& field, const string& piece);
+vector<pair<int, int>> fuzzyLookup(const FieldIndex& field, const string& term, int maxDistance);
+string normalizeKey(const string& str);
+int editDistance(const string& a, const string& b);
+void searchByDestination(Fleet& fleet);
+void searchByStatus(Fleet& fleet);
+void updateTruckStatus(Fleet& fleet);
+void deleteTruck(Fleet& fleet);
+void sortTrucks(Fleet& fleet);
+void dispatchTrucks(Fleet& fleet);
+bool isDispatchable(const Truck& truck);
+long long dispatchPriority(const Truck& truck);
+void trackDispatchStatus(DispatchScheduler& dispatch, const Truck& truck, int sign);
+void enqueueForDispatch(DispatchScheduler& dispatch, const Truck& truck);
+void rebuildDispatch(const vector<Truck>& trucks, DispatchScheduler& dispatch);
+vector<int> dispatchTopTrucks(vector<Truck>& trucks, const vector<int>& slots, RollupStore& rollups,
+                              DispatchScheduler& dispatch, const string& destination, int perDestination);
 void generateStatistics(const vector<Truck>& trucks);
-void generateReport(const vector<Truck>& trucks);
-void exportToCSV(const vector<Truck>& trucks);
-void saveToFile(const vector<Truck>& trucks);
-void loadFromFile(vector<Truck>& trucks);
+void generateReports(Fleet& fleet);
+void generateReport(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files);
+void generateDeltaReport(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files);
+void writeReportEntry(ostream& report, const Truck& truck);
+void generateRollupReport(Fleet& fleet);
+string rollupBucket(const string& timestamp, RollupGranularity granularity);
+void applyToRollups(RollupStore& rollups, const Truck& truck, int sign);
+void rebuildRollups(const vector<Truck>& trucks, RollupStore& rollups);
+vector<RollupRow> queryRollups(const RollupStore& rollups, RollupGranularity granularity,
+                               const string& from, const string& to, int groupBy);
+void exportData(Fleet& fleet);
+void exportToCSV(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files);
+void exportToCSVIncremental(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files);
+void refreshCSV(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files, int batch);
+bool writeFullCSV(const vector<Truck>& trucks, const string& path);
+void writeCSVRow(ostream& file, const Truck& truck);
+int readWatermarkValue(const string& path, const string& key);
+bool writeWatermark(const string& path, int batch, int snapshot, size_t records, size_t trucks);
+unsigned long long csvRowFingerprint(const Truck& truck);
+string stateRecord(unsigned long long value);
+bool writeExportState(const string& path, const vector<Truck>& trucks);
+bool patchExportState(const string& path, const vector<Truck>& trucks, const vector<int>& changed);
+bool readExportState(const string& path, vector<unsigned long long>& fingerprints);
+vector<int> diffExportState(const vector<Truck>& trucks, const vector<unsigned long long>& fingerprints);
+void markChanged(ChangeLog& changes, int truckNumber);
+void markRangeChanged(ChangeLog& changes, int first, int last);
+void markChanged(ChangeSet& changes, int truckNumber);
+void markRangeChanged(ChangeSet& changes, int first, int last);
+void resetChangeSet(ChangeSet& changes, size_t fleetSize);
+size_t changedCount(const ChangeSet& changes);
+vector<int> changedTrucks(const ChangeSet& changes);
+void exportToColumnar(const vector<Truck>& trucks, const string& path);
+long long timestampToEpoch(const string& timestamp);
+void writeVarint(string& out, unsigned long long value);
+void writeSignedVarint(string& out, long long value);
+void writeBytes(string& out, const string& value);
+void encodeColumn(const ColumnBuffer& column, string& out, ColumnStats& stats);
+void saveToFile(const vector<Truck>& trucks, const string& path = DATA_FILE);
+void loadFromFile(vector<Truck>& trucks, const string& path = DATA_FILE);
+int findTruck(const vector<Truck>& trucks, int truckNumber);
+void renumberTrucks(Fleet& fleet, size_t first);
+int cmdAddTruck(Fleet& fleet, const string& driver, const string& plate, const string& destination,
+                int emptyWeight, const vector<Box>& boxes, const string& timestamp = "");
+bool cmdUpdateStatus(Fleet& fleet, int truckNumber, const string& status);
+bool cmdDeleteTruck(Fleet& fleet, int truckNumber);
+bool cmdSortTrucks(Fleet& fleet, int sortKey);
+vector<pair<int, int>> cmdSearch(Fleet& fleet, SearchField field, const string& term, int maxDistance);
+vector<int> cmdDispatch(Fleet& fleet, const string& destination, int perDestination);
+vector<RollupRow> cmdRollupQuery(Fleet& fleet, RollupGranularity granularity,
+                                 const string& from, const string& to, int groupBy);
+bool cmdReport(Fleet& fleet, const string& kind);
+bool cmdExport(Fleet& fleet, const string& format);
+void cmdSave(Fleet& fleet);
+string cmdViewPage(Fleet& fleet, size_t page, size_t pageSize,
+                   const string& message = "", bool selecting = false);
+void loadFleet(Fleet& fleet, const string& path);
+void journalCommand(Fleet& fleet, const vector<string>& fields);
+void journalSnapshot(Fleet& fleet);
+vector<string> splitFields(const string& line);
+bool executeCommand(Fleet& fleet, const vector<string>& fields);
+int runReplay(const string& path);
+int generateScript(const string& path, int commands, unsigned seed);
+void printUsage(const char* program);
 void autoBackup(const vector<Truck>& trucks);
 int getValidatedInt(const string& prompt, int min = INT_MIN, int max = INT_MAX);
 string getValidatedString(const string& prompt);
 void clearScreen();
+void presentFrame(const string& frame);
+int terminalRows();
+string repeatString(const string& str, size_t count);
 void pauseScreen();
 string getCurrentDateTime();
 void displayProgressBar(int current, int total);
 string toUpperCase(string str);
 
-int main() {
+int main(int argc, char* argv[]) {
     #ifdef _WIN32
     SetConsoleOutputCP(65001);
     SetConsoleCP(65001);
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD consoleMode = 0;
+    if (GetConsoleMode(console, &consoleMode)) {
+        SetConsoleMode(console, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
     #endif
 
-    vector<Truck> trucks;
+    string mode = (argc >= 2) ? argv[1] : "";
+    if (mode == "--replay" && argc >= 3) return runReplay(argv[2]);
+    if (mode == "--generate" && argc >= 4) {
+        return generateScript(argv[2], atoi(argv[3]), argc >= 5 ? (unsigned)strtoul(argv[4], NULL, 10) : 1);
+    }
+    if (!mode.empty() && !(mode == "--record" && argc >= 3)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Fleet fleet;
+    ofstream journal;
+    if (mode == "--record") {
+        journal.open(argv[2]);
+        if (!journal) { cerr << "Cannot open journal file: " << argv[2] << "\n"; return 1; }
+        fleet.journal = &journal;
+    }
+
     int choice;
     bool dataModified = false;
 
-    loadFromFile(trucks);
+    loadFleet(fleet, fleet.files.data);
+    if (fleet.journal) journalSnapshot(fleet);
 
     do {
         clearScreen();
         displayHeader();
         displayMainMenu();
 
-        choice = getValidatedInt("Enter your choice: ", 1, 12);
+        choice = getValidatedInt("Enter your choice: ", 1, 13);
 
         switch(choice) {
             case 1:
-                addTrucks(trucks);
+                addTrucks(fleet);
                 dataModified = true;
                 break;
             case 2:
-                viewAllTrucks(trucks);
-                pauseScreen();
+                viewAllTrucks(fleet);
                 break;
             case 3:
-                viewDetailedTruckInfo(trucks);
+                viewDetailedTruckInfo(fleet);
                 pauseScreen();
                 break;
             case 4:
-                searchTrucks(trucks);
+                searchTrucks(fleet);
                 break;
             case 5:
-                updateTruckStatus(trucks);
+                updateTruckStatus(fleet);
                 dataModified = true;
                 break;
             case 6:
-                deleteTruck(trucks);
+                deleteTruck(fleet);
                 dataModified = true;
                 break;
             case 7:
-                sortTrucks(trucks);
-                pauseScreen();
+                sortTrucks(fleet);
                 break;
             case 8:
-                generateStatistics(trucks);
+                generateStatistics(fleet.trucks);
                 pauseScreen();
                 break;
             case 9:
-                generateReport(trucks);
-                pauseScreen();
+                generateReports(fleet);
                 break;
             case 10:
-                exportToCSV(trucks);
-                pauseScreen();
+                exportData(fleet);
                 break;
             case 11:
-                saveToFile(trucks);
+                cmdSave(fleet);
                 dataModified = false;
                 pauseScreen();
                 break;
             case 12:
+                dispatchTrucks(fleet);
+                dataModified = true;
+                pauseScreen();
+                break;
+            case 13:
                 if (dataModified) {
                     cout << "\n\t\tYou have unsaved changes. Save before exiting? (y/n): ";
                     char save;
                     cin >> save;
                     cin.ignore(numeric_limits<streamsize>::max(), '\n');
                     if (save == 'y' || save == 'Y') {
-                        saveToFile(trucks);
+                        cmdSave(fleet);
                     }
                 }
                 cout << "\n\n\t\t╔════════════════════════════════════════════════╗\n";
@@ -214,11 +558,11 @@ int main() {
                 pauseScreen();
         }
 
-        if (dataModified && choice != 11 && choice != 12) {
-            autoBackup(trucks);
+        if (dataModified && choice != 11 && choice != 13) {
+            autoBackup(fleet.trucks);
         }
 
-    } while(choice != 12);
+    } while(choice != 13);
 
     return 0;
 }
@@ -231,11 +575,45 @@ string getCurrentDateTime() {
 }
 
 void clearScreen() {
+    presentFrame(ANSI_CLEAR);
+}
+
+// Writes a fully composed frame with a single write so the terminal never
+// shows a half-drawn screen.
+void presentFrame(const string& frame) {
+    cout.flush();
+    fflush(stdout);
+    #ifdef _WIN32
+        DWORD written = 0;
+        WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), frame.data(), (DWORD)frame.size(), &written, NULL);
+    #else
+        size_t offset = 0;
+        while (offset < frame.size()) {
+            ssize_t written = write(STDOUT_FILENO, frame.data() + offset, frame.size() - offset);
+            if (written <= 0) break;
+            offset += (size_t)written;
+        }
+    #endif
+}
+
+int terminalRows() {
     #ifdef _WIN32
-        system("cls");
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+            return info.srWindow.Bottom - info.srWindow.Top + 1;
+        }
     #else
-        system("clear");
+        winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) return size.ws_row;
     #endif
+    return 24;
+}
+
+string repeatString(const string& str, size_t count) {
+    string result;
+    result.reserve(str.size() * count);
+    for (size_t i = 0; i < count; i++) result += str;
+    return result;
 }
 
 void pauseScreen() {
@@ -249,6 +627,64 @@ string toUpperCase(string str) {
     return str;
 }
 
+// Drops ASCII separators and upper-cases ASCII letters. Bytes >= 0x80 are
+// kept as-is so names in other scripts still index and accents still count.
+string normalizeKey(const string& str) {
+    string key;
+    key.reserve(str.size());
+    for (unsigned char c : str) {
+        if (c >= 0x80) key += (char)c;
+        else if (c >= 'a' && c <= 'z') key += (char)(c - 'a' + 'A');
+        else if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) key += (char)c;
+    }
+    return key;
+}
+
+// Levenshtein distance. Uses Myers' bit-parallel algorithm when the shorter
+// string fits in a 64-bit word, which covers every plate and driver name.
+int editDistance(const string& a, const string& b) {
+    const string& pattern = (a.size() <= b.size()) ? a : b;
+    const string& text = (a.size() <= b.size()) ? b : a;
+    size_t m = pattern.size();
+    if (m == 0) return (int)text.size();
+
+    if (m > 64) {
+        vector<int> row(m + 1);
+        for (size_t i = 0; i <= m; i++) row[i] = (int)i;
+        for (size_t j = 1; j <= text.size(); j++) {
+            int diagonal = row[0];
+            row[0] = (int)j;
+            for (size_t i = 1; i <= m; i++) {
+                int above = row[i];
+                int cost = (pattern[i - 1] == text[j - 1]) ? 0 : 1;
+                row[i] = min(min(row[i] + 1, row[i - 1] + 1), diagonal + cost);
+                diagonal = above;
+            }
+        }
+        return row[m];
+    }
+
+    uint64_t peq[256] = {};
+    for (size_t i = 0; i < m; i++) peq[(unsigned char)pattern[i]] |= 1ULL << i;
+
+    uint64_t pv = ~0ULL, mv = 0, last = 1ULL << (m - 1);
+    int score = (int)m;
+    for (unsigned char c : text) {
+        uint64_t eq = peq[c];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
 int getValidatedInt(const string& prompt, int min, int max) {
     int value;
     while (true) {
@@ -297,12 +733,12 @@ void displayProgressBar(int current, int total) {
     if (current == total) cout << endl;
 }
 
-void displayHeader() {
-    cout << "\n\t╔════════════════════════════════════════════════════════════════════╗\n";
-    cout << "\t║          TRUCK WEIGHT MANAGEMENT SYSTEM - PROFESSIONAL             ║\n";
-    cout << "\t╠════════════════════════════════════════════════════════════════════╣\n";
-    cout << "\t║  Current Session: " << left << setw(48) << getCurrentDateTime() << "║\n";
-    cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
+void displayHeader(ostream& out) {
+    out << "\n\t╔════════════════════════════════════════════════════════════════════╗\n";
+    out << "\t║          TRUCK WEIGHT MANAGEMENT SYSTEM - PROFESSIONAL             ║\n";
+    out << "\t╠════════════════════════════════════════════════════════════════════╣\n";
+    out << "\t║  Current Session: " << left << setw(48) << getCurrentDateTime() << "║\n";
+    out << "\t╚════════════════════════════════════════════════════════════════════╝\n";
 }
 
 void displayMainMenu() {
@@ -317,10 +753,11 @@ void displayMainMenu() {
     cout << "\t║  6.  Delete Truck                                                  ║\n";
     cout << "\t║  7.  Sort Trucks                                                   ║\n";
     cout << "\t║  8.  Generate Statistics                                           ║\n";
-    cout << "\t║  9.  Generate Report (Text File)                                   ║\n";
-    cout << "\t║  10. Export to CSV                                                 ║\n";
+    cout << "\t║  9.  Reports (Text File / Tonnage Rollups)                         ║\n";
+    cout << "\t║  10. Export Data (CSV / Columnar)                                  ║\n";
     cout << "\t║  11. Save Data                                                     ║\n";
-    cout << "\t║  12. Exit System                                                   ║\n";
+    cout << "\t║  12. Dispatch Ready Trucks                                         ║\n";
+    cout << "\t║  13. Exit System                                                   ║\n";
     cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
 }
 
@@ -336,7 +773,29 @@ void displaySearchMenu() {
     cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
 }
 
-void addTrucks(vector<Truck>& trucks) {
+void displayExportMenu() {
+    cout << "\n\t╔════════════════════════════════════════════════════════════════════╗\n";
+    cout << "\t║                       EXPORT OPTIONS                               ║\n";
+    cout << "\t╠════════════════════════════════════════════════════════════════════╣\n";
+    cout << "\t║  1. CSV (Truck Summary)                                            ║\n";
+    cout << "\t║  2. CSV Incremental (Changes Since Last Export)                    ║\n";
+    cout << "\t║  3. Columnar Analytics File (Trucks + Boxes)                       ║\n";
+    cout << "\t║  4. Back to Main Menu                                              ║\n";
+    cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
+}
+
+void displayReportsMenu() {
+    cout << "\n\t╔════════════════════════════════════════════════════════════════════╗\n";
+    cout << "\t║                       REPORT OPTIONS                               ║\n";
+    cout << "\t╠════════════════════════════════════════════════════════════════════╣\n";
+    cout << "\t║  1. Full Truck Report (Text File)                                  ║\n";
+    cout << "\t║  2. Delta Report (Changes Since Last Report)                       ║\n";
+    cout << "\t║  3. Tonnage Rollups (Hour / Day / Week)                            ║\n";
+    cout << "\t║  4. Back to Main Menu                                              ║\n";
+    cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
+}
+
+void addTrucks(Fleet& fleet) {
     clearScreen();
     displayHeader();
 
@@ -348,7 +807,7 @@ void addTrucks(vector<Truck>& trucks) {
 
     for (int i = 0; i < numTrucks; i++) {
         cout << "\n\t" << string(68, '─') << "\n";
-        cout << "\t  TRUCK #" << (trucks.size() + 1) << " - Registration\n";
+        cout << "\t  TRUCK #" << (fleet.trucks.size() + 1) << " - Registration\n";
         cout << "\t" << string(68, '─') << "\n";
 
         string driver = getValidatedString("\tDriver Name: ");
@@ -356,20 +815,20 @@ void addTrucks(vector<Truck>& trucks) {
         string destination = getValidatedString("\tDestination: ");
         int emptyWeight = getValidatedInt("\tEmpty Truck Weight (kg): ", 0, 10000);
 
-        Truck newTruck(trucks.size() + 1, emptyWeight, driver, plate, destination);
-
+        vector<Box> boxes;
         int numBoxes = getValidatedInt("\tNumber of Boxes: ", 0, 1000);
 
         for (int j = 0; j < numBoxes; j++) {
             cout << "\n\t  Box #" << (j + 1) << ":\n";
             int boxWeight = getValidatedInt("\t    Weight (kg): ", 0, 5000);
             string boxDesc = getValidatedString("\t    Description: ");
-            newTruck.boxes.push_back(Box(boxWeight, boxDesc));
+            boxes.push_back(Box(boxWeight, boxDesc));
 
             displayProgressBar(j + 1, numBoxes);
         }
 
-        newTruck.calculateTotalWeight();
+        int truckNumber = cmdAddTruck(fleet, driver, plate, destination, emptyWeight, boxes);
+        const Truck& newTruck = fleet.trucks[truckNumber - 1];
 
         cout << "\n\n\t" << string(68, '═') << "\n";
         cout << "\t  TRUCK SUMMARY\n";
@@ -390,53 +849,112 @@ void addTrucks(vector<Truck>& trucks) {
                  << newTruck.getRemainingCapacity() << " kg\n";
         }
         cout << "\t" << string(68, '═') << "\n";
-
-        trucks.push_back(newTruck);
     }
 
     cout << "\n\t  ✓ Successfully added " << numTrucks << " truck(s)!\n";
     pauseScreen();
 }
 
-void viewAllTrucks(const vector<Truck>& trucks) {
-    clearScreen();
-    displayHeader();
-
+// Paginated listing. Each frame formats only the rows on the current page,
+// so redrawing costs the same for ten trucks or a million. When selecting,
+// "#ID" picks a truck and returns its ID; otherwise returns 0.
+int viewAllTrucks(Fleet& fleet, const string& message, bool selecting) {
+    const vector<Truck>& trucks = fleet.trucks;
     if (trucks.empty()) {
+        clearScreen();
+        displayHeader();
         cout << "\n\t  ⚠ No trucks in the system!\n";
-        return;
+        pauseScreen();
+        return 0;
     }
 
-    cout << "\n\t" << string(130, '═') << "\n";
-    cout << "\t" << left << setw(6) << "ID"
-         << setw(20) << "Driver"
-         << setw(15) << "License"
-         << setw(18) << "Destination"
-         << setw(10) << "Weight"
-         << setw(10) << "Load %"
-         << setw(15) << "Status"
-         << setw(20) << "Timestamp" << "\n";
-    cout << "\t" << string(130, '─') << "\n";
+    size_t pageSize = (size_t)max(5, terminalRows() - 17);
+    size_t pageCount = (trucks.size() + pageSize - 1) / pageSize;
+    size_t page = 0;
 
-    for (size_t i = 0; i < trucks.size(); i++) {
+    while (true) {
+        presentFrame(cmdViewPage(fleet, page, pageSize, message, selecting));
+
+        string command;
+        if (!getline(cin, command)) return 0;
+        if (command.empty()) {
+            // Enter pages forward and leaves once there is nothing left to show.
+            if (page + 1 >= pageCount) return 0;
+            command = "N";
+        }
+
+        char key = (char)toupper((unsigned char)command[0]);
+        if (key == 'Q') return 0;
+        if (key == '#' && selecting) {
+            long truckId = atol(command.c_str() + 1);
+            if (truckId >= 1 && (size_t)truckId <= trucks.size()) return (int)truckId;
+        } else if (key == 'N' && page + 1 < pageCount) page++;
+        else if (key == 'P' && page > 0) page--;
+        else if (key == 'F') page = 0;
+        else if (key == 'L') page = pageCount - 1;
+        else if (isdigit((unsigned char)key)) {
+            size_t target = (size_t)atol(command.c_str());
+            if (target >= 1 && target <= pageCount) page = target - 1;
+        }
+    }
+}
+
+string composeTruckPage(const vector<Truck>& trucks, size_t page, size_t pageSize,
+                        const string& message, bool selecting) {
+    size_t pageCount = (trucks.size() + pageSize - 1) / pageSize;
+    size_t first = page * pageSize;
+    size_t last = min(first + pageSize, trucks.size());
+
+    ostringstream frame;
+    frame << ANSI_CLEAR;
+    displayHeader(frame);
+    if (!message.empty()) frame << "\n\t  " << message << "\n";
+    renderTruckRows(frame, trucks, first, last);
+    frame << "\t  Page " << (page + 1) << " of " << pageCount
+          << " | Trucks " << (first + 1) << "-" << last << " of " << trucks.size() << "\n";
+    frame << "\n\t  [Enter] " << (page + 1 < pageCount ? "Next" : "Done") << "  [N]ext  [P]rev  [F]irst  [L]ast  [page #] Go to  "
+          << (selecting ? "[#ID] Select  " : "") << "[Q]uit: ";
+    return frame.str();
+}
+
+// Truck IDs are positions, so any ID up to the fleet size is valid.
+int pickTruck(Fleet& fleet, const string& action) {
+    int truckId = viewAllTrucks(fleet, "Type #ID to pick the truck to " + action + ", or Q to enter its ID.", true);
+    if (truckId > 0) return truckId;
+    return getValidatedInt("\n\tEnter Truck ID to " + action + ": ", 1, (int)fleet.trucks.size());
+}
+
+void renderTruckRows(ostream& out, const vector<Truck>& trucks, size_t first, size_t last) {
+    out << "\n\t" << repeatString("═", 130) << "\n";
+    out << "\t" << left << setw(6) << "ID"
+        << setw(20) << "Driver"
+        << setw(15) << "License"
+        << setw(18) << "Destination"
+        << setw(10) << "Weight"
+        << setw(10) << "Load %"
+        << setw(15) << "Status"
+        << setw(20) << "Timestamp" << "\n";
+    out << "\t" << repeatString("─", 130) << "\n";
+
+    for (size_t i = first; i < last; i++) {
         string dName = trucks[i].driverName.length() > 18 ? trucks[i].driverName.substr(0,15) + "..." : trucks[i].driverName;
         string dest = trucks[i].destination.length() > 16 ? trucks[i].destination.substr(0,13) + "..." : trucks[i].destination;
 
-        cout << "\t" << left << setw(6) << trucks[i].truckNumber
-             << setw(20) << dName
-             << setw(15) << trucks[i].licensePlate
-             << setw(18) << dest
-             << setw(10) << trucks[i].totalWeight
-             << setw(10) << fixed << setprecision(1) << trucks[i].getLoadPercentage()
-             << setw(15) << trucks[i].status
-             << setw(20) << trucks[i].timestamp.substr(0, 19) << "\n";
+        out << "\t" << left << setw(6) << trucks[i].truckNumber
+            << setw(20) << dName
+            << setw(15) << trucks[i].licensePlate
+            << setw(18) << dest
+            << setw(10) << trucks[i].totalWeight
+            << setw(10) << fixed << setprecision(1) << trucks[i].getLoadPercentage()
+            << setw(15) << trucks[i].status
+            << setw(20) << trucks[i].timestamp.substr(0, 19) << "\n";
     }
 
-    cout << "\t" << string(130, '═') << "\n";
-    cout << "\t  Total Trucks: " << trucks.size() << "\n";
+    out << "\t" << repeatString("═", 130) << "\n";
 }
 
-void viewDetailedTruckInfo(const vector<Truck>& trucks) {
+void viewDetailedTruckInfo(Fleet& fleet) {
+    const vector<Truck>& trucks = fleet.trucks;
     clearScreen();
     displayHeader();
 
@@ -445,8 +963,7 @@ void viewDetailedTruckInfo(const vector<Truck>& trucks) {
         return;
     }
 
-    viewAllTrucks(trucks);
-    int truckId = getValidatedInt("\n\tEnter Truck ID to view details: ", 1, 9999);
+    int truckId = pickTruck(fleet, "view details");
 
     for (size_t i = 0; i < trucks.size(); i++) {
         if (trucks[i].truckNumber == truckId) {
@@ -506,7 +1023,7 @@ void viewDetailedTruckInfo(const vector<Truck>& trucks) {
     cout << "\n\t  ⚠ Truck not found!\n";
 }
 
-void searchTrucks(const vector<Truck>& trucks) {
+void searchTrucks(Fleet& fleet) {
     int choice;
     do {
         clearScreen();
@@ -514,155 +1031,452 @@ void searchTrucks(const vector<Truck>& trucks) {
         displaySearchMenu();
         choice = getValidatedInt("Enter your choice: ", 1, 5);
         switch(choice) {
-            case 1: searchByDriver(trucks); pauseScreen(); break;
-            case 2: searchByPlate(trucks); pauseScreen(); break;
-            case 3: searchByDestination(trucks); pauseScreen(); break;
-            case 4: searchByStatus(trucks); pauseScreen(); break;
+            case 1: searchByDriver(fleet); pauseScreen(); break;
+            case 2: searchByPlate(fleet); pauseScreen(); break;
+            case 3: searchByDestination(fleet); pauseScreen(); break;
+            case 4: searchByStatus(fleet); pauseScreen(); break;
             case 5: break;
         }
     } while(choice != 5);
 }
 
-void searchByDriver(const vector<Truck>& trucks) {
+void BKTree::insert(const string& key, int serial) {
+    if (key.empty()) return;
+    if (nodes.empty()) { nodes.push_back(BKNode(key, serial)); return; }
+
+    size_t current = 0;
+    while (true) {
+        int distance = editDistance(key, nodes[current].key);
+        if (distance == 0) { nodes[current].serials.push_back(serial); return; }
+
+        bool descended = false;
+        for (const auto& child : nodes[current].children) {
+            if (child.first == distance) { current = child.second; descended = true; break; }
+        }
+        if (!descended) {
+            nodes.push_back(BKNode(key, serial));
+            nodes[current].children.push_back(make_pair(distance, (int)nodes.size() - 1));
+            return;
+        }
+    }
+}
+
+void BKTree::remove(const string& key, int serial) {
+    if (key.empty() || nodes.empty()) return;
+
+    size_t current = 0;
+    while (true) {
+        int distance = editDistance(key, nodes[current].key);
+        if (distance == 0) {
+            vector<int>& serials = nodes[current].serials;
+            serials.erase(std::remove(serials.begin(), serials.end(), serial), serials.end());
+            return;
+        }
+
+        bool descended = false;
+        for (const auto& child : nodes[current].children) {
+            if (child.first == distance) { current = child.second; descended = true; break; }
+        }
+        if (!descended) return;
+    }
+}
+
+void BKTree::query(const string& key, int maxDistance, vector<pair<int, int>>& matches) const {
+    if (nodes.empty()) return;
+
+    vector<int> pending(1, 0);
+    while (!pending.empty()) {
+        const BKNode& node = nodes[pending.back()];
+        pending.pop_back();
+
+        int distance = editDistance(key, node.key);
+        if (distance <= maxDistance) {
+            for (int serial : node.serials) matches.push_back(make_pair(distance, serial));
+        }
+        for (const auto& child : node.children) {
+            if (child.first >= distance - maxDistance && child.first <= distance + maxDistance) {
+                pending.push_back(child.second);
+            }
+        }
+    }
+}
+
+void rebuildSearchIndex(const vector<Truck>& trucks, SearchIndex& index) {
+    index.drivers = FieldIndex();
+    index.plates = FieldIndex();
+    for (const auto& truck : trucks) addToSearchIndex(index, truck);
+
+    // Sorting may have left serials out of order; postings must ascend.
+    for (FieldIndex* field : { &index.drivers, &index.plates }) {
+        for (auto& posting : field->grams) sort(posting.second.begin(), posting.second.end());
+    }
+}
+
+void addToSearchIndex(SearchIndex& index, const Truck& truck) {
+    indexKey(index.drivers, truck.serial, normalizeKey(truck.driverName));
+    indexKey(index.plates, truck.serial, normalizeKey(truck.licensePlate));
+}
+
+void removeFromSearchIndex(SearchIndex& index, const Truck& truck) {
+    unindexKey(index.drivers, truck.serial);
+    unindexKey(index.plates, truck.serial);
+}
+
+void indexKey(FieldIndex& field, int serial, const string& key) {
+    if (field.keys.size() <= (size_t)serial) field.keys.resize(serial + 1);
+    field.keys[serial] = key;
+    field.tree.insert(key, serial);
+    for (const string& gram : keyGrams(key)) field.grams[gram].push_back(serial);
+}
+
+void unindexKey(FieldIndex& field, int serial) {
+    if ((size_t)serial >= field.keys.size()) return;
+    const string& key = field.keys[serial];
+    field.tree.remove(key, serial);
+    for (const string& gram : keyGrams(key)) {
+        vector<int>& posting = field.grams[gram];
+        auto it = lower_bound(posting.begin(), posting.end(), serial);
+        if (it != posting.end() && *it == serial) posting.erase(it);
+    }
+    field.keys[serial].clear();
+}
+
+vector<string> keyGrams(const string& key) {
+    vector<string> grams;
+    for (size_t i = 0; i + 2 <= key.size(); i++) grams.push_back(key.substr(i, 2));
+    for (size_t i = 0; i + 3 <= key.size(); i++) grams.push_back(key.substr(i, 3));
+    sort(grams.begin(), grams.end());
+    grams.erase(unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// Every key containing piece (two bytes or more) is in the returned posting.
+const vector<int>& shortestPosting(const FieldIndex& field, const string& piece) {
+    static const vector<int> none;
+    const vector<int>* shortest = NULL;
+    size_t gramSize = min((size_t)3, piece.size());
+    for (size_t i = 0; i + gramSize <= piece.size(); i++) {
+        auto it = field.grams.find(piece.substr(i, gramSize));
+        if (it == field.grams.end()) return none;
+        if (!shortest || it->second.size() < shortest->size()) shortest = &it->second;
+    }
+    return *shortest;
+}
+
+// Returns (distance, serial) pairs. Normalized substring hits count as
+// distance 0 and are verified against the term's shortest gram posting.
+// For fuzzy hits, a key within maxDistance edits must contain one of
+// maxDistance + 1 disjoint pieces of the term intact, so the pieces'
+// postings bound the candidates. The BK-tree is used instead when the
+// pieces are too short or their postings outnumber its distinct keys.
+vector<pair<int, int>> fuzzyLookup(const FieldIndex& field, const string& term, int maxDistance) {
+    string key = normalizeKey(term);
+    unordered_map<int, int> best;
+    if (key.empty()) return vector<pair<int, int>>();
+
+    if (key.size() >= 2) {
+        for (int serial : shortestPosting(field, key)) {
+            if (field.keys[serial].find(key) != string::npos) best[serial] = 0;
+        }
+    } else {
+        for (const auto& node : field.tree.nodes) {
+            if (node.key.find(key) == string::npos) continue;
+            for (int serial : node.serials) best[serial] = 0;
+        }
+    }
+
+    if (maxDistance > 0) {
+        size_t parts = maxDistance + 1;
+        vector<const vector<int>*> candidates;
+        size_t candidateCount = 0;
+        if (key.size() >= 2 * parts) {
+            for (size_t p = 0; p < parts; p++) {
+                size_t from = p * key.size() / parts, to = (p + 1) * key.size() / parts;
+                candidates.push_back(&shortestPosting(field, key.substr(from, to - from)));
+                candidateCount += candidates.back()->size();
+            }
+        }
+
+        if (!candidates.empty() && candidateCount < field.tree.nodes.size()) {
+            for (const vector<int>* posting : candidates) {
+                for (int serial : *posting) {
+                    if (best.count(serial)) continue;
+                    int distance = editDistance(field.keys[serial], key);
+                    if (distance <= maxDistance) best[serial] = distance;
+                }
+            }
+        } else {
+            vector<pair<int, int>> fuzzy;
+            field.tree.query(key, maxDistance, fuzzy);
+            for (const auto& hit : fuzzy) {
+                auto it = best.find(hit.second);
+                if (it == best.end() || hit.first < it->second) best[hit.second] = hit.first;
+            }
+        }
+    }
+
+    vector<pair<int, int>> results;
+    results.reserve(best.size());
+    for (const auto& entry : best) results.push_back(make_pair(entry.second, entry.first));
+    return results;
+}
+
+void searchByDriver(Fleet& fleet) {
     string searchTerm = getValidatedString("\n\tEnter driver name to search: ");
-    searchTerm = toUpperCase(searchTerm);
+    int maxDistance = getValidatedInt("\tAllowed typing errors (0-3): ", 0, 3);
+    vector<pair<int, int>> results = cmdSearch(fleet, SEARCH_DRIVER, searchTerm, maxDistance);
+
     cout << "\n\t  Search Results:\n";
     cout << "\t  " << string(68, '─') << "\n";
-    bool found = false;
-    for (const auto& truck : trucks) {
-        if (toUpperCase(truck.driverName).find(searchTerm) != string::npos) {
-            cout << "\t  ID: " << truck.truckNumber << " | Driver: " << truck.driverName
-                 << " | Plate: " << truck.licensePlate << " | Status: " << truck.status << "\n";
-            found = true;
-        }
+    for (const auto& result : results) {
+        const Truck& truck = fleet.trucks[result.second];
+        cout << "\t  " << (result.first == 0 ? "[exact] " : "[~" + to_string(result.first) + "]    ")
+             << "ID: " << truck.truckNumber << " | Driver: " << truck.driverName
+             << " | Plate: " << truck.licensePlate << " | Status: " << truck.status << "\n";
     }
-    if (!found) cout << "\t  No matches found.\n";
+    if (results.empty()) cout << "\t  No matches found.\n";
     cout << "\t  " << string(68, '─') << "\n";
 }
 
-void searchByPlate(const vector<Truck>& trucks) {
+void searchByPlate(Fleet& fleet) {
     string searchTerm = getValidatedString("\n\tEnter license plate to search: ");
-    searchTerm = toUpperCase(searchTerm);
+    int maxDistance = getValidatedInt("\tAllowed typing errors (0-3): ", 0, 3);
+    vector<pair<int, int>> results = cmdSearch(fleet, SEARCH_PLATE, searchTerm, maxDistance);
+
     cout << "\n\t  Search Results:\n";
     cout << "\t  " << string(68, '─') << "\n";
-    bool found = false;
-    for (const auto& truck : trucks) {
-        if (toUpperCase(truck.licensePlate).find(searchTerm) != string::npos) {
-             cout << "\t  ID: " << truck.truckNumber << " | Driver: " << truck.driverName
-                 << " | Plate: " << truck.licensePlate << " | Dest: " << truck.destination << "\n";
-            found = true;
-        }
+    for (const auto& result : results) {
+        const Truck& truck = fleet.trucks[result.second];
+        cout << "\t  " << (result.first == 0 ? "[exact] " : "[~" + to_string(result.first) + "]    ")
+             << "ID: " << truck.truckNumber << " | Driver: " << truck.driverName
+             << " | Plate: " << truck.licensePlate << " | Dest: " << truck.destination << "\n";
     }
-    if (!found) cout << "\t  No matches found.\n";
+    if (results.empty()) cout << "\t  No matches found.\n";
     cout << "\t  " << string(68, '─') << "\n";
 }
 
-void searchByDestination(const vector<Truck>& trucks) {
+void searchByDestination(Fleet& fleet) {
     string searchTerm = getValidatedString("\n\tEnter destination to search: ");
-    searchTerm = toUpperCase(searchTerm);
+    vector<pair<int, int>> results = cmdSearch(fleet, SEARCH_DESTINATION, searchTerm, 0);
+
     cout << "\n\t  Search Results:\n";
     cout << "\t  " << string(68, '─') << "\n";
-    bool found = false;
-    for (const auto& truck : trucks) {
-        if (toUpperCase(truck.destination).find(searchTerm) != string::npos) {
-             cout << "\t  ID: " << truck.truckNumber << " | Dest: " << truck.destination
-                 << " | Weight: " << truck.totalWeight << "kg\n";
-            found = true;
-        }
+    for (const auto& result : results) {
+        const Truck& truck = fleet.trucks[result.second];
+        cout << "\t  ID: " << truck.truckNumber << " | Dest: " << truck.destination
+             << " | Weight: " << truck.totalWeight << "kg\n";
     }
-    if (!found) cout << "\t  No matches found.\n";
+    if (results.empty()) cout << "\t  No matches found.\n";
     cout << "\t  " << string(68, '─') << "\n";
 }
 
-void searchByStatus(const vector<Truck>& trucks) {
+void searchByStatus(Fleet& fleet) {
     cout << "\n\t  Status Options: 1. Ready, 2. Near Limit, 3. Overloaded, 4. Pending\n";
     int choice = getValidatedInt("\n\tSelect status: ", 1, 4);
     string status = (choice==1) ? "Ready" : (choice==2) ? "Near Limit" : (choice==3) ? "Overloaded" : "Pending";
+    vector<pair<int, int>> results = cmdSearch(fleet, SEARCH_STATUS, status, 0);
 
     cout << "\n\t  Trucks with status '" << status << "':\n";
     cout << "\t  " << string(68, '─') << "\n";
-    bool found = false;
-    for (const auto& truck : trucks) {
-        if (truck.status == status) {
-             cout << "\t  ID: " << truck.truckNumber << " | Driver: " << truck.driverName
-                 << " | Weight: " << truck.totalWeight << " kg\n";
-            found = true;
-        }
+    for (const auto& result : results) {
+        const Truck& truck = fleet.trucks[result.second];
+        cout << "\t  ID: " << truck.truckNumber << " | Driver: " << truck.driverName
+             << " | Weight: " << truck.totalWeight << " kg\n";
     }
-    if (!found) cout << "\t  No trucks with this status.\n";
+    if (results.empty()) cout << "\t  No trucks with this status.\n";
     cout << "\t  " << string(68, '─') << "\n";
 }
 
-void updateTruckStatus(vector<Truck>& trucks) {
+void updateTruckStatus(Fleet& fleet) {
     clearScreen();
     displayHeader();
-    if (trucks.empty()) { cout << "\n\t  ⚠ No trucks!\n"; pauseScreen(); return; }
-
-    viewAllTrucks(trucks);
-    int truckId = getValidatedInt("\n\tEnter Truck ID to update: ", 1, 9999);
-
-    for (auto& truck : trucks) {
-        if (truck.truckNumber == truckId) {
-            cout << "\n\t  Current Status: " << truck.status << "\n";
-            cout << "\n\t  New Status Options:\n\t  1. Pending\n\t  2. In Transit\n\t  3. Delivered\n\t  4. Cancelled\n";
-            int choice = getValidatedInt("\n\tSelect new status: ", 1, 4);
-            switch(choice) {
-                case 1: truck.status = "Pending"; break;
-                case 2: truck.status = "In Transit"; break;
-                case 3: truck.status = "Delivered"; break;
-                case 4: truck.status = "Cancelled"; break;
-            }
-            cout << "\n\t  ✓ Status updated successfully!\n";
-            pauseScreen();
-            return;
-        }
+    if (fleet.trucks.empty()) { cout << "\n\t  ⚠ No trucks!\n"; pauseScreen(); return; }
+
+    int truckId = pickTruck(fleet, "update");
+
+    int slot = findTruck(fleet.trucks, truckId);
+    if (slot < 0) {
+        cout << "\n\t  ⚠ Truck not found!\n";
+        pauseScreen();
+        return;
     }
-    cout << "\n\t  ⚠ Truck not found!\n";
+
+    cout << "\n\t  Current Status: " << fleet.trucks[slot].status << "\n";
+    cout << "\n\t  New Status Options:\n\t  1. Pending\n\t  2. In Transit\n\t  3. Delivered\n\t  4. Cancelled\n";
+    int choice = getValidatedInt("\n\tSelect new status: ", 1, 4);
+    cmdUpdateStatus(fleet, truckId, MANUAL_STATUSES[choice - 1]);
+    cout << "\n\t  ✓ Status updated successfully!\n";
     pauseScreen();
 }
 
-void deleteTruck(vector<Truck>& trucks) {
+void deleteTruck(Fleet& fleet) {
     clearScreen();
     displayHeader();
-    if (trucks.empty()) { cout << "\n\t  ⚠ No trucks!\n"; pauseScreen(); return; }
+    if (fleet.trucks.empty()) { cout << "\n\t  ⚠ No trucks!\n"; pauseScreen(); return; }
 
-    viewAllTrucks(trucks);
-    int truckId = getValidatedInt("\n\tEnter Truck ID to delete: ", 1, 9999);
+    int truckId = pickTruck(fleet, "delete");
 
-    for (size_t i = 0; i < trucks.size(); i++) {
-        if (trucks[i].truckNumber == truckId) {
-            cout << "\n\t  Delete Truck #" << trucks[i].truckNumber << " (" << trucks[i].driverName << ")?\n";
-            cout << "\t  Confirm? (y/n): ";
-            char confirm; cin >> confirm;
-            if (confirm == 'y' || confirm == 'Y') {
-                trucks.erase(trucks.begin() + i);
-                for (size_t j = 0; j < trucks.size(); j++) trucks[j].truckNumber = j + 1;
-                cout << "\n\t  ✓ Truck deleted successfully!\n";
-            } else {
-                cout << "\n\t  Deletion cancelled.\n";
-            }
-            pauseScreen();
-            return;
-        }
+    int slot = findTruck(fleet.trucks, truckId);
+    if (slot < 0) {
+        cout << "\n\t  ⚠ Truck not found!\n";
+        pauseScreen();
+        return;
+    }
+
+    cout << "\n\t  Delete Truck #" << truckId << " (" << fleet.trucks[slot].driverName << ")?\n";
+    cout << "\t  Confirm? (y/n): ";
+    char confirm; cin >> confirm;
+    if (confirm == 'y' || confirm == 'Y') {
+        cmdDeleteTruck(fleet, truckId);
+        cout << "\n\t  ✓ Truck deleted successfully!\n";
+    } else {
+        cout << "\n\t  Deletion cancelled.\n";
     }
-    cout << "\n\t  ⚠ Truck not found!\n";
     pauseScreen();
 }
 
-void sortTrucks(vector<Truck>& trucks) {
-    if (trucks.empty()) { cout << "\n\t  ⚠ No trucks to sort!\n"; return; }
+void sortTrucks(Fleet& fleet) {
+    if (fleet.trucks.empty()) { cout << "\n\t  ⚠ No trucks to sort!\n"; pauseScreen(); return; }
     cout << "\n\t  Sort By: 1. Weight (Asc), 2. Weight (Desc), 3. Driver, 4. Timestamp\n";
     int choice = getValidatedInt("\n\tSelect sort option: ", 1, 4);
 
-    switch(choice) {
-        case 1: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.totalWeight < b.totalWeight; }); break;
-        case 2: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.totalWeight > b.totalWeight; }); break;
-        case 3: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.driverName < b.driverName; }); break;
-        case 4: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.timestamp < b.timestamp; }); break;
+    cmdSortTrucks(fleet, choice);
+    viewAllTrucks(fleet, "✓ Trucks sorted!");
+}
+
+bool isDispatchable(const Truck& truck) {
+    return truck.status == "Ready" || truck.status == "Near Limit";
+}
+
+// Older trucks go first; every percent of load counts as
+// LOAD_PRIORITY_SECONDS of extra waiting time.
+long long dispatchPriority(const Truck& truck) {
+    return timestampToEpoch(truck.timestamp) - (long long)(truck.getLoadPercentage() * LOAD_PRIORITY_SECONDS);
+}
+
+void trackDispatchStatus(DispatchScheduler& dispatch, const Truck& truck, int sign) {
+    if (isDispatchable(truck)) dispatch.waiting[truck.destination] += sign;
+    else if (truck.status == "Overloaded") dispatch.held[truck.destination] += sign;
+}
+
+void enqueueForDispatch(DispatchScheduler& dispatch, const Truck& truck) {
+    trackDispatchStatus(dispatch, truck, +1);
+    if (isDispatchable(truck)) {
+        dispatch.queues[truck.destination].push(DispatchEntry(dispatchPriority(truck), truck.serial));
+    }
+}
+
+void rebuildDispatch(const vector<Truck>& trucks, DispatchScheduler& dispatch) {
+    map<string, vector<DispatchEntry>> entries;
+    dispatch.waiting.clear();
+    dispatch.held.clear();
+    for (const auto& truck : trucks) {
+        trackDispatchStatus(dispatch, truck, +1);
+        if (isDispatchable(truck)) {
+            entries[truck.destination].push_back(DispatchEntry(dispatchPriority(truck), truck.serial));
+        }
+    }
+
+    dispatch.queues.clear();
+    for (auto& entry : entries) {
+        dispatch.queues[entry.first] = DispatchQueue(greater<DispatchEntry>(), move(entry.second));
+    }
+}
+
+// Pops up to perDestination live entries from one destination's queue,
+// skipping entries left behind by deletes and status changes.
+void dispatchFromQueue(vector<Truck>& trucks, const vector<int>& slots, RollupStore& rollups,
+                       DispatchScheduler& dispatch, const string& destination, DispatchQueue& queue,
+                       int perDestination, vector<int>& dispatched) {
+    int sent = 0;
+    while (sent < perDestination && !queue.empty()) {
+        int slot = slots[queue.top().serial];
+        queue.pop();
+
+        if (slot < 0) continue;
+        Truck& truck = trucks[slot];
+        if (!isDispatchable(truck) || truck.destination != destination) continue;
+
+        applyToRollups(rollups, truck, -1);
+        trackDispatchStatus(dispatch, truck, -1);
+        truck.status = "In Transit";
+        applyToRollups(rollups, truck, +1);
+
+        dispatched.push_back(truck.truckNumber);
+        sent++;
+    }
+}
+
+// Moves up to perDestination trucks from the front of each queue (or only
+// the named destination's queue) to In Transit. Returns their truck numbers.
+vector<int> dispatchTopTrucks(vector<Truck>& trucks, const vector<int>& slots, RollupStore& rollups,
+                              DispatchScheduler& dispatch, const string& destination, int perDestination) {
+    vector<int> dispatched;
+    if (!destination.empty()) {
+        auto it = dispatch.queues.find(destination);
+        if (it == dispatch.queues.end()) return dispatched;
+        dispatchFromQueue(trucks, slots, rollups, dispatch, it->first, it->second, perDestination, dispatched);
+        if (it->second.empty()) dispatch.queues.erase(it);
+        return dispatched;
+    }
+
+    for (auto it = dispatch.queues.begin(); it != dispatch.queues.end(); ) {
+        dispatchFromQueue(trucks, slots, rollups, dispatch, it->first, it->second, perDestination, dispatched);
+        if (it->second.empty()) it = dispatch.queues.erase(it);
+        else ++it;
+    }
+    return dispatched;
+}
+
+void dispatchTrucks(Fleet& fleet) {
+    DispatchScheduler& dispatch = fleet.dispatch;
+    clearScreen();
+    displayHeader();
+
+    cout << "\n\t╔════════════════════════════════════════════════════════════════════╗\n";
+    cout << "\t║                      DISPATCH QUEUES                               ║\n";
+    cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
+
+    cout << "\n\t  " << left << setw(6) << "#" << setw(30) << "Destination" << setw(12) << "Waiting"
+         << setw(20) << "Held (Overloaded)" << "\n";
+    cout << "\t  " << repeatString("─", 72) << "\n";
+
+    set<string> names;
+    for (const auto& entry : dispatch.waiting) if (entry.second > 0) names.insert(entry.first);
+    for (const auto& entry : dispatch.held) if (entry.second > 0) names.insert(entry.first);
+
+    // Destinations are picked by number, since long names are truncated below.
+    vector<string> destinations(names.begin(), names.end());
+    int totalWaiting = 0;
+    for (size_t i = 0; i < destinations.size(); i++) {
+        const string& name = destinations[i];
+        int waiting = dispatch.waiting.count(name) ? dispatch.waiting[name] : 0;
+        int held = dispatch.held.count(name) ? dispatch.held[name] : 0;
+        string dest = name.length() > 28 ? name.substr(0, 25) + "..." : name;
+        cout << "\t  " << left << setw(6) << (i + 1) << setw(30) << dest << setw(12) << waiting
+             << setw(20) << held << "\n";
+        totalWaiting += waiting;
+    }
+    cout << "\t  " << repeatString("─", 72) << "\n";
+
+    if (totalWaiting == 0) { cout << "\n\t  ⚠ No trucks are waiting for dispatch!\n"; return; }
+
+    int perDestination = getValidatedInt("\n\tTrucks to dispatch per destination (0 to cancel): ", 0, 1000);
+    if (perDestination == 0) { cout << "\n\t  Dispatch cancelled.\n"; return; }
+    int choice = getValidatedInt("\tDestination # (0 for all): ", 0, (int)destinations.size());
+    string destination = choice == 0 ? "" : destinations[choice - 1];
+
+    vector<int> dispatched = cmdDispatch(fleet, destination, perDestination);
+    if (dispatched.empty()) { cout << "\n\t  ⚠ No trucks dispatched!\n"; return; }
+
+    cout << "\n\t  Dispatched:\n";
+    for (int number : dispatched) {
+        const Truck& truck = fleet.trucks[number - 1];
+        cout << "\t  ID: " << truck.truckNumber << " | Driver: " << truck.driverName
+             << " | Dest: " << truck.destination << " | Load: " << fixed << setprecision(1)
+             << truck.getLoadPercentage() << "%\n";
     }
-    for (size_t i = 0; i < trucks.size(); i++) trucks[i].truckNumber = i + 1;
-    cout << "\n\t  ✓ Trucks sorted!\n";
-    viewAllTrucks(trucks);
+    cout << "\n\t  ✓ " << dispatched.size() << " truck(s) now In Transit.\n";
 }
 
 void generateStatistics(const vector<Truck>& trucks) {
@@ -705,55 +1519,700 @@ void generateStatistics(const vector<Truck>& trucks) {
     cout << "\t╚════════════════════════════════════════════════════════════════════╝\n";
 }
 
-void generateReport(const vector<Truck>& trucks) {
-    if (trucks.empty()) { cout << "\n\t  ⚠ No data available!\n"; return; }
-
-    ofstream report(REPORT_FILE);
-    if (!report) { cout << "\n\t  ⚠ Error creating report file!\n"; return; }
-
+void generateReports(Fleet& fleet) {
+    int choice;
+    do {
+        clearScreen();
+        displayHeader();
+        displayReportsMenu();
+        choice = getValidatedInt("Enter your choice: ", 1, 4);
+        switch(choice) {
+            case 1: cmdReport(fleet, "full"); pauseScreen(); break;
+            case 2: cmdReport(fleet, "delta"); pauseScreen(); break;
+            case 3: generateRollupReport(fleet); pauseScreen(); break;
+            case 4: break;
+        }
+    } while(choice != 4);
+}
+
+void generateReport(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files) {
+    if (trucks.empty()) { cout << "\n\t  ⚠ No data available!\n"; return; }
+
+    ofstream report(files.report);
+    if (!report) { cout << "\n\t  ⚠ Error creating report file!\n"; return; }
+
     report << "TRUCK WEIGHT MANAGEMENT SYSTEM - REPORT\n";
     report << "Generated: " << getCurrentDateTime() << "\n";
     report << "---------------------------------------\n\n";
 
-    for (const auto& truck : trucks) {
-        report << "Truck #" << truck.truckNumber << "\n";
-        report << "Driver: " << truck.driverName << "\n";
-        report << "Plate: " << truck.licensePlate << "\n";
-        report << "Destination: " << truck.destination << "\n";
-        report << "Total Weight: " << truck.totalWeight << " kg\n";
-        report << "Status: " << truck.status << "\n";
-        report << "Timestamp: " << truck.timestamp << "\n";
-        report << "Boxes: " << truck.boxes.size() << "\n\n";
+    for (const auto& truck : trucks) writeReportEntry(report, truck);
+
+    resetChangeSet(changes.report, trucks.size());
+
+    cout << "\n\t  ✓ Report generated: " << files.report << "\n";
+}
+
+void writeReportEntry(ostream& report, const Truck& truck) {
+    report << "Truck #" << truck.truckNumber << "\n";
+    report << "Driver: " << truck.driverName << "\n";
+    report << "Plate: " << truck.licensePlate << "\n";
+    report << "Destination: " << truck.destination << "\n";
+    report << "Total Weight: " << truck.totalWeight << " kg\n";
+    report << "Status: " << truck.status << "\n";
+    report << "Timestamp: " << truck.timestamp << "\n";
+    report << "Boxes: " << truck.boxes.size() << "\n\n";
+}
+
+void generateDeltaReport(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files) {
+    if (!changes.report.baseline) {
+        cout << "\n\t  No report baseline this session yet - generating the full report.\n";
+        generateReport(trucks, changes, files);
+        return;
+    }
+
+    size_t count = changedCount(changes.report);
+    if (count == 0) { cout << "\n\t  ✓ No changes since the last report.\n"; return; }
+    if (!trucks.empty() && count > trucks.size() * DELTA_FULL_RATIO) {
+        cout << "\n\t  " << count << " record(s) changed - generating the full report instead.\n";
+        generateReport(trucks, changes, files);
+        return;
+    }
+
+    vector<int> changed = changedTrucks(changes.report);
+
+    ofstream report(files.deltaReport);
+    if (!report) { cout << "\n\t  ⚠ Error creating report file!\n"; return; }
+
+    report << "TRUCK WEIGHT MANAGEMENT SYSTEM - DELTA REPORT\n";
+    report << "Generated: " << getCurrentDateTime() << "\n";
+    report << "Changed Records: " << changed.size() << "\n";
+    report << "---------------------------------------\n\n";
+
+    for (int number : changed) {
+        if ((size_t)number <= trucks.size()) writeReportEntry(report, trucks[number - 1]);
+        else report << "Truck #" << number << "\nRemoved\n\n";
+    }
+
+    resetChangeSet(changes.report, trucks.size());
+
+    cout << "\n\t  ✓ Delta report generated: " << files.deltaReport
+         << " (" << changed.size() << " changed record(s))\n";
+}
+
+string rollupBucket(const string& timestamp, RollupGranularity granularity) {
+    if (timestamp.size() < 13) return "Unknown";
+    if (granularity == ROLLUP_HOUR) return timestamp.substr(0, 13) + ":00";
+    if (granularity == ROLLUP_DAY) return timestamp.substr(0, 10);
+
+    tm date = {};
+    if (sscanf(timestamp.c_str(), "%d-%d-%d", &date.tm_year, &date.tm_mon, &date.tm_mday) != 3) return "Unknown";
+    date.tm_year -= 1900;
+    date.tm_mon -= 1;
+    date.tm_hour = 12;
+    date.tm_isdst = -1;
+    mktime(&date);
+    date.tm_mday -= (date.tm_wday + 6) % 7;
+    mktime(&date);
+
+    char buffer[16];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d", &date);
+    return string(buffer);
+}
+
+void applyToRollups(RollupStore& rollups, const Truck& truck, int sign) {
+    for (int g = ROLLUP_HOUR; g <= ROLLUP_WEEK; g++) {
+        RollupKey key(rollupBucket(truck.timestamp, (RollupGranularity)g), truck.destination, truck.status);
+        RollupCell& cell = rollups.cubes[g][key];
+        cell.trucks += sign;
+        cell.tonnage += sign * (long long)truck.totalWeight;
+        if (cell.trucks <= 0) rollups.cubes[g].erase(key);
     }
+}
+
+void rebuildRollups(const vector<Truck>& trucks, RollupStore& rollups) {
+    for (auto& cube : rollups.cubes) cube.clear();
+    for (const auto& truck : trucks) applyToRollups(rollups, truck, +1);
+}
+
+// groupBy: 1 = destination, 2 = status, 3 = destination and status.
+// Range bounds are inclusive bucket prefixes; an empty bound is open.
+vector<RollupRow> queryRollups(const RollupStore& rollups, RollupGranularity granularity,
+                               const string& from, const string& to, int groupBy) {
+    const map<RollupKey, RollupCell>& cube = rollups.cubes[granularity];
+    map<pair<string, string>, RollupCell> grouped;
+
+    for (auto it = cube.lower_bound(RollupKey(from, "", "")); it != cube.end(); ++it) {
+        const string& bucket = get<0>(it->first);
+        if (!to.empty() && bucket.compare(0, to.size(), to) > 0) break;
+
+        string group = (groupBy == 1) ? get<1>(it->first)
+                     : (groupBy == 2) ? get<2>(it->first)
+                     : get<1>(it->first) + " / " + get<2>(it->first);
+        RollupCell& cell = grouped[make_pair(bucket, group)];
+        cell.trucks += it->second.trucks;
+        cell.tonnage += it->second.tonnage;
+    }
+
+    vector<RollupRow> rows;
+    for (const auto& entry : grouped) {
+        RollupRow row;
+        row.bucket = entry.first.first;
+        row.group = entry.first.second;
+        row.cell = entry.second;
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+void generateRollupReport(Fleet& fleet) {
+    cout << "\n\t  Granularity: 1. Hourly, 2. Daily, 3. Weekly\n";
+    RollupGranularity granularity = (RollupGranularity)(getValidatedInt("\n\tSelect granularity: ", 1, 3) - 1);
+    cout << "\n\t  Group By: 1. Destination, 2. Status, 3. Destination & Status\n";
+    int groupBy = getValidatedInt("\n\tSelect grouping: ", 1, 3);
+    string from = getValidatedString("\tFrom (e.g. 2026-10-01, * for earliest): ");
+    string to = getValidatedString("\tTo   (e.g. 2026-10-31, * for latest): ");
+    if (from == "*") from = "";
+    if (to == "*") to = "";
+
+    vector<RollupRow> rows = cmdRollupQuery(fleet, granularity, from, to, groupBy);
+    if (rows.empty()) { cout << "\n\t  ⚠ No data in the selected range!\n"; return; }
+
+    string bucketTitle = (granularity == ROLLUP_HOUR) ? "Hour" : (granularity == ROLLUP_DAY) ? "Day" : "Week Of";
+    string groupTitle = (groupBy == 1) ? "Destination" : (groupBy == 2) ? "Status" : "Destination / Status";
+
+    cout << "\n\t" << repeatString("═", 90) << "\n";
+    cout << "\t" << left << setw(20) << bucketTitle
+         << setw(36) << groupTitle
+         << setw(10) << "Trucks"
+         << setw(14) << "Weight (kg)"
+         << setw(10) << "Tonnes" << "\n";
+    cout << "\t" << repeatString("─", 90) << "\n";
+
+    int totalTrucks = 0;
+    long long totalTonnage = 0;
+    for (const auto& row : rows) {
+        string group = row.group.length() > 34 ? row.group.substr(0, 31) + "..." : row.group;
+        cout << "\t" << left << setw(20) << row.bucket
+             << setw(36) << group
+             << setw(10) << row.cell.trucks
+             << setw(14) << row.cell.tonnage
+             << setw(10) << fixed << setprecision(2) << (row.cell.tonnage / 1000.0) << "\n";
+        totalTrucks += row.cell.trucks;
+        totalTonnage += row.cell.tonnage;
+    }
+
+    cout << "\t" << repeatString("═", 90) << "\n";
+    cout << "\t  Total: " << totalTrucks << " truck(s), " << totalTonnage << " kg ("
+         << fixed << setprecision(2) << (totalTonnage / 1000.0) << " t)\n";
+}
 
-    cout << "\n\t  ✓ Report generated: " << REPORT_FILE << "\n";
+void exportData(Fleet& fleet) {
+    int choice;
+    do {
+        clearScreen();
+        displayHeader();
+        displayExportMenu();
+        choice = getValidatedInt("Enter your choice: ", 1, 4);
+        switch(choice) {
+            case 1: cmdExport(fleet, "csv"); pauseScreen(); break;
+            case 2: cmdExport(fleet, "incremental"); pauseScreen(); break;
+            case 3: cmdExport(fleet, "columnar"); pauseScreen(); break;
+            case 4: break;
+        }
+    } while(choice != 4);
 }
 
-void exportToCSV(const vector<Truck>& trucks) {
+// A full export is the baseline for incremental ones: it restarts the
+// change file and resets the watermark to batch 0.
+void exportToCSV(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files) {
     if (trucks.empty()) { cout << "\n\t  ⚠ No data available!\n"; return; }
 
-    ofstream file(CSV_FILE);
-    if (!file) { cout << "\n\t  ⚠ Error creating CSV file!\n"; return; }
+    if (!writeFullCSV(trucks, files.csv)) { cout << "\n\t  ⚠ Error creating CSV file!\n"; return; }
+
+    ofstream changeFile(files.csvChanges);
+    changeFile << "Batch,Op,ID,Driver,Plate,Destination,EmptyWeight,TotalWeight,Status,Timestamp,BoxCount\n";
+    if (!changeFile || !writeExportState(files.csvState, trucks) ||
+        !writeWatermark(files.csvWatermark, 0, 0, trucks.size(), trucks.size())) {
+        cout << "\n\t  ⚠ Error writing watermark file!\n";
+        return;
+    }
+
+    resetChangeSet(changes.csv, trucks.size());
+
+    cout << "\n\t  ✓ Exported to: " << files.csv << "\n";
+}
+
+// Rewrites the full CSV as the given batch when a delta would be too large,
+// keeping the change file and the batch numbering. The watermark's snapshot
+// then tells readers to reload the CSV and skip change rows up to it.
+void refreshCSV(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files, int batch) {
+    if (!writeFullCSV(trucks, files.csv)) { cout << "\n\t  ⚠ Error creating CSV file!\n"; return; }
+
+    if (!writeExportState(files.csvState, trucks) ||
+        !writeWatermark(files.csvWatermark, batch, batch, trucks.size(), trucks.size())) {
+        cout << "\n\t  ⚠ Error writing watermark file!\n";
+        return;
+    }
+
+    resetChangeSet(changes.csv, trucks.size());
+
+    cout << "\n\t  ✓ Batch " << batch << " written as a full refresh to: " << files.csv << "\n";
+}
+
+bool writeFullCSV(const vector<Truck>& trucks, const string& path) {
+    ofstream file(path);
+    if (!file) return false;
 
     file << "ID,Driver,Plate,Destination,EmptyWeight,TotalWeight,Status,Timestamp,BoxCount\n";
+    for (const auto& truck : trucks) writeCSVRow(file, truck);
+    file.close();
+    return !file.fail();
+}
+
+void writeCSVRow(ostream& file, const Truck& truck) {
+    file << truck.truckNumber << ","
+         << truck.driverName << ","
+         << truck.licensePlate << ","
+         << truck.destination << ","
+         << truck.emptyWeight << ","
+         << truck.totalWeight << ","
+         << truck.status << ","
+         << truck.timestamp << ","
+         << truck.boxes.size() << "\n";
+}
+
+// Appends one batch of UPSERT / DELETE rows to the change file, touching
+// only trucks logged since the previous export. A new session has no log
+// yet, so its first batch compares the fleet with the fingerprints the
+// last export left in the state file instead.
+void exportToCSVIncremental(const vector<Truck>& trucks, ChangeLog& changes, const OutputFiles& files) {
+    int lastBatch = readWatermarkValue(files.csvWatermark, "batch");
+    if (lastBatch < 0) {
+        cout << "\n\t  No previous export found - running a full export.\n";
+        exportToCSV(trucks, changes, files);
+        return;
+    }
+
+    vector<int> changed;
+    size_t count;
+    if (changes.csv.baseline) {
+        count = changedCount(changes.csv);
+    } else {
+        vector<unsigned long long> fingerprints;
+        if (!readExportState(files.csvState, fingerprints)) {
+            cout << "\n\t  No export state found - refreshing the full export.\n";
+            refreshCSV(trucks, changes, files, lastBatch + 1);
+            return;
+        }
+        changed = diffExportState(trucks, fingerprints);
+        count = changed.size();
+    }
+
+    if (count == 0) {
+        resetChangeSet(changes.csv, trucks.size());
+        cout << "\n\t  ✓ No changes since batch " << lastBatch << ".\n";
+        return;
+    }
+    if (!trucks.empty() && count > trucks.size() * DELTA_FULL_RATIO) {
+        cout << "\n\t  " << count << " record(s) changed - refreshing the full export instead.\n";
+        refreshCSV(trucks, changes, files, lastBatch + 1);
+        return;
+    }
+
+    if (changes.csv.baseline) changed = changedTrucks(changes.csv);
+    int snapshot = max(0, readWatermarkValue(files.csvWatermark, "snapshot"));
+
+    ofstream file(files.csvChanges, ios::app);
+    if (!file) { cout << "\n\t  ⚠ Error opening " << files.csvChanges << "!\n"; return; }
 
+    int batch = lastBatch + 1;
+    for (int number : changed) {
+        if ((size_t)number <= trucks.size()) {
+            file << batch << ",UPSERT,";
+            writeCSVRow(file, trucks[number - 1]);
+        } else {
+            file << batch << ",DELETE," << number << ",,,,,,,,\n";
+        }
+    }
+    file.close();
+
+    if (file.fail() || !patchExportState(files.csvState, trucks, changed) ||
+        !writeWatermark(files.csvWatermark, batch, snapshot, changed.size(), trucks.size())) {
+        cout << "\n\t  ⚠ Error writing watermark file!\n";
+        return;
+    }
+
+    resetChangeSet(changes.csv, trucks.size());
+
+    cout << "\n\t  ✓ Batch " << batch << " appended to: " << files.csvChanges
+         << " (" << changed.size() << " changed record(s))\n";
+}
+
+// Returns the watermark's key=value entry, or -1 when it is missing.
+int readWatermarkValue(const string& path, const string& key) {
+    ifstream file(path);
+    string line;
+    while (getline(file, line)) {
+        if (line.compare(0, key.size() + 1, key + "=") == 0) return atoi(line.c_str() + key.size() + 1);
+    }
+    return -1;
+}
+
+// snapshot is the batch that truck_export.csv was last written at; change
+// rows up to it are already part of the CSV.
+bool writeWatermark(const string& path, int batch, int snapshot, size_t records, size_t trucks) {
+    ofstream file(path);
+    file << "batch=" << batch << "\n";
+    file << "snapshot=" << snapshot << "\n";
+    file << "exported=" << getCurrentDateTime() << "\n";
+    file << "records=" << records << "\n";
+    file << "trucks=" << trucks << "\n";
+    file.close();
+    return !file.fail();
+}
+
+// 64-bit FNV-1a hash of the CSV row an export writes for the truck.
+unsigned long long csvRowFingerprint(const Truck& truck) {
+    ostringstream row;
+    writeCSVRow(row, truck);
+    unsigned long long hash = 14695981039346656037ULL;
+    for (char c : row.str()) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// The state file is a row count followed by one fingerprint per exported
+// row, each a fixed-width hex line, so a batch can rewrite just the lines
+// of the trucks it touched.
+string stateRecord(unsigned long long value) {
+    char record[STATE_RECORD_WIDTH + 1];
+    snprintf(record, sizeof(record), "%016llx\n", value);
+    return record;
+}
+
+bool writeExportState(const string& path, const vector<Truck>& trucks) {
+    ofstream file(path, ios::binary);
+    file << stateRecord(trucks.size());
+    for (const auto& truck : trucks) file << stateRecord(csvRowFingerprint(truck));
+    file.close();
+    return !file.fail();
+}
+
+// changed must be ascending, as changedTrucks returns it; numbers past the
+// fleet size were deleted and only shrink the row count.
+bool patchExportState(const string& path, const vector<Truck>& trucks, const vector<int>& changed) {
+    fstream file(path, ios::in | ios::out | ios::binary);
+    if (!file) return false;
+
+    file << stateRecord(trucks.size());
+    for (int number : changed) {
+        if ((size_t)number > trucks.size()) break;
+        file.seekp(number * STATE_RECORD_WIDTH);
+        file << stateRecord(csvRowFingerprint(trucks[number - 1]));
+    }
+    file.close();
+    return !file.fail();
+}
+
+bool readExportState(const string& path, vector<unsigned long long>& fingerprints) {
+    ifstream file(path);
+    string line;
+    if (!getline(file, line)) return false;
+
+    size_t count = strtoull(line.c_str(), NULL, 16);
+    fingerprints.clear();
+    while (fingerprints.size() < count && getline(file, line)) {
+        fingerprints.push_back(strtoull(line.c_str(), NULL, 16));
+    }
+    return fingerprints.size() == count;
+}
+
+// Truck numbers whose row no longer matches the last export, ascending.
+vector<int> diffExportState(const vector<Truck>& trucks, const vector<unsigned long long>& fingerprints) {
+    vector<int> changed;
+    size_t last = max(trucks.size(), fingerprints.size());
+    for (size_t i = 0; i < last; i++) {
+        if (i >= trucks.size() || i >= fingerprints.size() ||
+            csvRowFingerprint(trucks[i]) != fingerprints[i]) changed.push_back((int)i + 1);
+    }
+    return changed;
+}
+
+void markChanged(ChangeLog& changes, int truckNumber) {
+    markChanged(changes.csv, truckNumber);
+    markChanged(changes.report, truckNumber);
+}
+
+void markRangeChanged(ChangeLog& changes, int first, int last) {
+    markRangeChanged(changes.csv, first, last);
+    markRangeChanged(changes.report, first, last);
+}
+
+void markChanged(ChangeSet& changes, int truckNumber) {
+    if (!changes.baseline) return;
+    if (truckNumber < changes.shiftedFrom) changes.numbers.insert(truckNumber);
+    changes.highWater = max(changes.highWater, truckNumber);
+}
+
+void markRangeChanged(ChangeSet& changes, int first, int last) {
+    if (!changes.baseline || first > last) return;
+    changes.shiftedFrom = min(changes.shiftedFrom, first);
+    changes.numbers.erase(changes.numbers.lower_bound(changes.shiftedFrom), changes.numbers.end());
+    changes.highWater = max(changes.highWater, last);
+}
+
+void resetChangeSet(ChangeSet& changes, size_t fleetSize) {
+    changes.baseline = true;
+    changes.numbers.clear();
+    changes.shiftedFrom = INT_MAX;
+    changes.highWater = (int)fleetSize;
+}
+
+size_t changedCount(const ChangeSet& changes) {
+    size_t count = changes.numbers.size();
+    if (changes.shiftedFrom <= changes.highWater) count += changes.highWater - changes.shiftedFrom + 1;
+    return count;
+}
+
+// Changed truck numbers in ascending order.
+vector<int> changedTrucks(const ChangeSet& changes) {
+    vector<int> changed(changes.numbers.begin(), changes.numbers.end());
+    for (int number = changes.shiftedFrom; number <= changes.highWater; number++) changed.push_back(number);
+    return changed;
+}
+
+long long timestampToEpoch(const string& timestamp) {
+    tm date = {};
+    if (sscanf(timestamp.c_str(), "%d-%d-%d %d:%d:%d", &date.tm_year, &date.tm_mon, &date.tm_mday,
+               &date.tm_hour, &date.tm_min, &date.tm_sec) != 6) return 0;
+    date.tm_year -= 1900;
+    date.tm_mon -= 1;
+    date.tm_isdst = -1;
+    return (long long)mktime(&date);
+}
+
+void writeVarint(string& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+void writeSignedVarint(string& out, long long value) {
+    writeVarint(out, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+void writeBytes(string& out, const string& value) {
+    writeVarint(out, value.size());
+    out += value;
+}
+
+void encodeColumn(const ColumnBuffer& column, string& out, ColumnStats& stats) {
+    if (column.spec.type != COL_STRING) {
+        long long previous = 0;
+        for (size_t i = 0; i < column.ints.size(); i++) {
+            long long value = column.ints[i];
+            if (i == 0 || value < stats.minValue) stats.minValue = value;
+            if (i == 0 || value > stats.maxValue) stats.maxValue = value;
+            writeSignedVarint(out, column.spec.encoding == ENC_DELTA ? value - previous : value);
+            previous = value;
+        }
+
+        vector<long long> values(column.ints);
+        sort(values.begin(), values.end());
+        stats.distinct = unique(values.begin(), values.end()) - values.begin();
+        return;
+    }
+
+    for (size_t i = 0; i < column.strings.size(); i++) {
+        const string& value = column.strings[i];
+        if (i == 0 || value < stats.minString) stats.minString = value;
+        if (i == 0 || value > stats.maxString) stats.maxString = value;
+    }
+
+    if (column.spec.encoding == ENC_DICTIONARY) {
+        unordered_map<string, size_t> lookup;
+        vector<const string*> dictionary;
+        string indexes;
+        for (const auto& value : column.strings) {
+            auto inserted = lookup.insert(make_pair(value, dictionary.size()));
+            if (inserted.second) dictionary.push_back(&inserted.first->first);
+            writeVarint(indexes, inserted.first->second);
+        }
+        writeVarint(out, dictionary.size());
+        for (const string* entry : dictionary) writeBytes(out, *entry);
+        out += indexes;
+        stats.distinct = dictionary.size();
+    } else {
+        for (const auto& value : column.strings) writeBytes(out, value);
+
+        vector<const string*> values;
+        for (const auto& value : column.strings) values.push_back(&value);
+        sort(values.begin(), values.end(), [](const string* a, const string* b) { return *a < *b; });
+        stats.distinct = unique(values.begin(), values.end(),
+                                [](const string* a, const string* b) { return *a == *b; }) - values.begin();
+    }
+}
+
+bool ColumnarWriter::open(const string& path) {
+    out.open(path, ios::binary);
+    if (!out) return false;
+    out << COLUMNAR_MAGIC;
+    return true;
+}
+
+int ColumnarWriter::addTable(const string& name, const vector<ColumnSpec>& columns) {
+    ColumnarTable table;
+    table.name = name;
+    table.rows = 0;
+    for (const auto& spec : columns) {
+        ColumnBuffer buffer;
+        buffer.spec = spec;
+        table.columns.push_back(buffer);
+    }
+    tables.push_back(table);
+    return (int)tables.size() - 1;
+}
+
+void ColumnarWriter::endRow(int table) {
+    tables[table].rows++;
+    if (tables[table].rows == ROW_GROUP_SIZE) flushRowGroup(table);
+}
+
+void ColumnarWriter::flushRowGroup(int table) {
+    ColumnarTable& t = tables[table];
+    if (t.rows == 0) return;
+
+    RowGroupMeta meta;
+    meta.table = table;
+    meta.offset = (size_t)out.tellp();
+    meta.rows = t.rows;
+
+    string header;
+    header += (char)table;
+    writeVarint(header, t.rows);
+    out << header;
+
+    for (auto& column : t.columns) {
+        string data;
+        ColumnStats stats;
+        encodeColumn(column, data, stats);
+        stats.bytes = data.size();
+        meta.stats.push_back(stats);
+
+        string length;
+        writeVarint(length, data.size());
+        out << length << data;
+
+        column.ints.clear();
+        column.strings.clear();
+    }
+
+    rowGroups.push_back(meta);
+    t.rows = 0;
+}
+
+bool ColumnarWriter::close() {
+    for (size_t i = 0; i < tables.size(); i++) flushRowGroup((int)i);
+
+    string footer;
+    writeVarint(footer, tables.size());
+    for (const auto& table : tables) {
+        writeBytes(footer, table.name);
+        writeVarint(footer, table.columns.size());
+        for (const auto& column : table.columns) {
+            writeBytes(footer, column.spec.name);
+            footer += (char)column.spec.type;
+            footer += (char)column.spec.encoding;
+        }
+    }
+
+    writeVarint(footer, rowGroups.size());
+    for (const auto& group : rowGroups) {
+        footer += (char)group.table;
+        writeVarint(footer, group.offset);
+        writeVarint(footer, group.rows);
+        for (size_t c = 0; c < group.stats.size(); c++) {
+            const ColumnStats& stats = group.stats[c];
+            if (tables[group.table].columns[c].spec.type == COL_STRING) {
+                writeBytes(footer, stats.minString);
+                writeBytes(footer, stats.maxString);
+            } else {
+                writeSignedVarint(footer, stats.minValue);
+                writeSignedVarint(footer, stats.maxValue);
+            }
+            writeVarint(footer, stats.distinct);
+            writeVarint(footer, stats.bytes);
+        }
+    }
+
+    uint32_t length = (uint32_t)footer.size();
+    out << footer;
+    for (int i = 0; i < 4; i++) out.put((char)((length >> (8 * i)) & 0xFF));
+    out << COLUMNAR_MAGIC;
+    out.close();
+    return !out.fail();
+}
+
+void exportToColumnar(const vector<Truck>& trucks, const string& path) {
+    if (trucks.empty()) { cout << "\n\t  ⚠ No data available!\n"; return; }
+
+    ColumnarWriter writer;
+    if (!writer.open(path)) { cout << "\n\t  ⚠ Error creating columnar file!\n"; return; }
+
+    int truckTable = writer.addTable("trucks", {
+        {"id", COL_INT32, ENC_DELTA},
+        {"driver", COL_STRING, ENC_PLAIN},
+        {"plate", COL_STRING, ENC_PLAIN},
+        {"destination", COL_STRING, ENC_DICTIONARY},
+        {"empty_weight", COL_INT32, ENC_DELTA},
+        {"total_weight", COL_INT32, ENC_DELTA},
+        {"status", COL_STRING, ENC_DICTIONARY},
+        {"timestamp", COL_TIMESTAMP, ENC_DELTA},
+        {"box_count", COL_INT32, ENC_DELTA}
+    });
+    int boxTable = writer.addTable("boxes", {
+        {"truck_id", COL_INT32, ENC_DELTA},
+        {"box_number", COL_INT32, ENC_DELTA},
+        {"weight", COL_INT32, ENC_DELTA},
+        {"description", COL_STRING, ENC_DICTIONARY}
+    });
+
+    size_t boxCount = 0;
     for (const auto& truck : trucks) {
-        file << truck.truckNumber << ","
-             << truck.driverName << ","
-             << truck.licensePlate << ","
-             << truck.destination << ","
-             << truck.emptyWeight << ","
-             << truck.totalWeight << ","
-             << truck.status << ","
-             << truck.timestamp << ","
-             << truck.boxes.size() << "\n";
+        writer.appendInt(truckTable, 0, truck.truckNumber);
+        writer.appendString(truckTable, 1, truck.driverName);
+        writer.appendString(truckTable, 2, truck.licensePlate);
+        writer.appendString(truckTable, 3, truck.destination);
+        writer.appendInt(truckTable, 4, truck.emptyWeight);
+        writer.appendInt(truckTable, 5, truck.totalWeight);
+        writer.appendString(truckTable, 6, truck.status);
+        writer.appendInt(truckTable, 7, timestampToEpoch(truck.timestamp));
+        writer.appendInt(truckTable, 8, (long long)truck.boxes.size());
+        writer.endRow(truckTable);
+
+        for (size_t j = 0; j < truck.boxes.size(); j++) {
+            writer.appendInt(boxTable, 0, truck.truckNumber);
+            writer.appendInt(boxTable, 1, (long long)j + 1);
+            writer.appendInt(boxTable, 2, truck.boxes[j].weight);
+            writer.appendString(boxTable, 3, truck.boxes[j].description);
+            writer.endRow(boxTable);
+            boxCount++;
+        }
     }
 
-    cout << "\n\t  ✓ Exported to: " << CSV_FILE << "\n";
+    if (!writer.close()) { cout << "\n\t  ⚠ Error writing columnar file!\n"; return; }
+
+    cout << "\n\t  ✓ Exported to: " << path << "\n";
+    cout << "\t    Trucks: " << trucks.size() << " | Boxes: " << boxCount
+         << " | Row groups: " << writer.rowGroups.size() << "\n";
 }
 
-void saveToFile(const vector<Truck>& trucks) {
-    ofstream file(DATA_FILE);
+void saveToFile(const vector<Truck>& trucks, const string& path) {
+    ofstream file(path);
     if (!file) {
         cout << "\n\t  ⚠ Error saving data!\n";
         return;
@@ -777,8 +2236,8 @@ void saveToFile(const vector<Truck>& trucks) {
     cout << "\n\t  ✓ Data saved successfully.\n";
 }
 
-void loadFromFile(vector<Truck>& trucks) {
-    ifstream file(DATA_FILE);
+void loadFromFile(vector<Truck>& trucks, const string& path) {
+    ifstream file(path);
     if (!file) return;
 
     trucks.clear();
@@ -817,4 +2276,425 @@ void autoBackup(const vector<Truck>& trucks) {
     for (const auto& t : trucks) {
         file << t.truckNumber << "|" << t.driverName << "|" << t.totalWeight << "\n";
     }
-}
\ No newline at end of file
+}
+
+int findTruck(const vector<Truck>& trucks, int truckNumber) {
+    size_t slot = (size_t)truckNumber - 1;
+    if (truckNumber >= 1 && slot < trucks.size() && trucks[slot].truckNumber == truckNumber) return (int)slot;
+    for (size_t i = 0; i < trucks.size(); i++) {
+        if (trucks[i].truckNumber == truckNumber) return (int)i;
+    }
+    return -1;
+}
+
+void renumberTrucks(Fleet& fleet, size_t first) {
+    for (size_t i = first; i < fleet.trucks.size(); i++) {
+        fleet.trucks[i].truckNumber = i + 1;
+        fleet.slots[fleet.trucks[i].serial] = (int)i;
+    }
+}
+
+int cmdAddTruck(Fleet& fleet, const string& driver, const string& plate, const string& destination,
+                int emptyWeight, const vector<Box>& boxes, const string& timestamp) {
+    Truck truck((int)fleet.trucks.size() + 1, emptyWeight, driver, plate, destination);
+    if (!timestamp.empty()) truck.timestamp = timestamp;
+    truck.boxes = boxes;
+    truck.calculateTotalWeight();
+    truck.serial = (int)fleet.slots.size();
+
+    fleet.slots.push_back((int)fleet.trucks.size());
+    fleet.trucks.push_back(truck);
+    applyToRollups(fleet.rollups, truck, +1);
+    enqueueForDispatch(fleet.dispatch, truck);
+    markChanged(fleet.changes, truck.truckNumber);
+    addToSearchIndex(fleet.searchIndex, truck);
+
+    if (fleet.journal) {
+        vector<string> fields = { "add", driver, plate, destination, to_string(emptyWeight), truck.timestamp };
+        for (const auto& box : boxes) {
+            fields.push_back(to_string(box.weight));
+            fields.push_back(box.description);
+        }
+        journalCommand(fleet, fields);
+    }
+    return truck.truckNumber;
+}
+
+bool cmdUpdateStatus(Fleet& fleet, int truckNumber, const string& status) {
+    if (find(begin(MANUAL_STATUSES), end(MANUAL_STATUSES), status) == end(MANUAL_STATUSES)) return false;
+    int slot = findTruck(fleet.trucks, truckNumber);
+    if (slot < 0) return false;
+
+    Truck& truck = fleet.trucks[slot];
+    applyToRollups(fleet.rollups, truck, -1);
+    trackDispatchStatus(fleet.dispatch, truck, -1);
+    truck.status = status;
+    applyToRollups(fleet.rollups, truck, +1);
+    trackDispatchStatus(fleet.dispatch, truck, +1);
+    markChanged(fleet.changes, truckNumber);
+
+    journalCommand(fleet, { "status", to_string(truckNumber), status });
+    return true;
+}
+
+bool cmdDeleteTruck(Fleet& fleet, int truckNumber) {
+    int slot = findTruck(fleet.trucks, truckNumber);
+    if (slot < 0) return false;
+
+    vector<Truck>& trucks = fleet.trucks;
+    applyToRollups(fleet.rollups, trucks[slot], -1);
+    trackDispatchStatus(fleet.dispatch, trucks[slot], -1);
+    removeFromSearchIndex(fleet.searchIndex, trucks[slot]);
+    fleet.slots[trucks[slot].serial] = -1;
+    trucks.erase(trucks.begin() + slot);
+    renumberTrucks(fleet, slot);
+    markRangeChanged(fleet.changes, slot + 1, (int)trucks.size() + 1);
+
+    journalCommand(fleet, { "delete", to_string(truckNumber) });
+    return true;
+}
+
+bool cmdSortTrucks(Fleet& fleet, int sortKey) {
+    vector<Truck>& trucks = fleet.trucks;
+    switch(sortKey) {
+        case 1: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.totalWeight < b.totalWeight; }); break;
+        case 2: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.totalWeight > b.totalWeight; }); break;
+        case 3: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.driverName < b.driverName; }); break;
+        case 4: sort(trucks.begin(), trucks.end(), [](const Truck& a, const Truck& b) { return a.timestamp < b.timestamp; }); break;
+        default: return false;
+    }
+    renumberTrucks(fleet, 0);
+    markRangeChanged(fleet.changes, 1, (int)trucks.size());
+
+    journalCommand(fleet, { "sort", to_string(sortKey) });
+    return true;
+}
+
+// Returns (distance, truck index) pairs. Destination and status matches
+// are exact, so they always carry distance 0.
+vector<pair<int, int>> cmdSearch(Fleet& fleet, SearchField field, const string& term, int maxDistance) {
+    journalCommand(fleet, { "search", SEARCH_FIELD_NAMES[field], term, to_string(maxDistance) });
+
+    vector<pair<int, int>> results;
+    if (field == SEARCH_DRIVER || field == SEARCH_PLATE) {
+        SearchIndex& index = fleet.searchIndex;
+        results = fuzzyLookup(field == SEARCH_DRIVER ? index.drivers : index.plates, term, maxDistance);
+        for (auto& result : results) result.second = fleet.slots[result.second];
+        sort(results.begin(), results.end());
+        return results;
+    }
+
+
+    string upperTerm = toUpperCase(term);
+    for (size_t i = 0; i < fleet.trucks.size(); i++) {
+        const Truck& truck = fleet.trucks[i];
+        bool match = (field == SEARCH_STATUS) ? truck.status == term
+                                              : toUpperCase(truck.destination).find(upperTerm) != string::npos;
+        if (match) results.push_back(make_pair(0, (int)i));
+    }
+    return results;
+}
+
+vector<int> cmdDispatch(Fleet& fleet, const string& destination, int perDestination) {
+    vector<int> dispatched = dispatchTopTrucks(fleet.trucks, fleet.slots, fleet.rollups, fleet.dispatch,
+                                             destination, perDestination);
+    for (int number : dispatched) markChanged(fleet.changes, number);
+
+    journalCommand(fleet, { "dispatch", to_string(perDestination), destination.empty() ? "*" : destination });
+    return dispatched;
+}
+
+vector<RollupRow> cmdRollupQuery(Fleet& fleet, RollupGranularity granularity,
+                                 const string& from, const string& to, int groupBy) {
+    journalCommand(fleet, { "rollup", ROLLUP_GRANULARITY_NAMES[granularity], to_string(groupBy),
+                            from.empty() ? "*" : from, to.empty() ? "*" : to });
+    return queryRollups(fleet.rollups, granularity, from, to, groupBy);
+}
+
+bool cmdReport(Fleet& fleet, const string& kind) {
+    if (kind == "full") generateReport(fleet.trucks, fleet.changes, fleet.files);
+    else if (kind == "delta") generateDeltaReport(fleet.trucks, fleet.changes, fleet.files);
+    else return false;
+
+    journalCommand(fleet, { "report", kind });
+    return true;
+}
+
+bool cmdExport(Fleet& fleet, const string& format) {
+    if (format == "csv") exportToCSV(fleet.trucks, fleet.changes, fleet.files);
+    else if (format == "incremental") exportToCSVIncremental(fleet.trucks, fleet.changes, fleet.files);
+    else if (format == "columnar") exportToColumnar(fleet.trucks, fleet.files.columnar);
+    else return false;
+
+    journalCommand(fleet, { "export", format });
+    return true;
+}
+
+void cmdSave(Fleet& fleet) {
+    saveToFile(fleet.trucks, fleet.files.data);
+    journalCommand(fleet, { "save" });
+}
+
+string cmdViewPage(Fleet& fleet, size_t page, size_t pageSize, const string& message, bool selecting) {
+    journalCommand(fleet, { "view", to_string(page + 1), to_string(pageSize) });
+    if (fleet.trucks.empty() || pageSize == 0) return "";
+    size_t pageCount = (fleet.trucks.size() + pageSize - 1) / pageSize;
+    return composeTruckPage(fleet.trucks, min(page, pageCount - 1), pageSize, message, selecting);
+}
+
+void loadFleet(Fleet& fleet, const string& path) {
+    loadFromFile(fleet.trucks, path);
+    fleet.slots.clear();
+    for (size_t i = 0; i < fleet.trucks.size(); i++) {
+        fleet.trucks[i].serial = (int)i;
+        fleet.slots.push_back((int)i);
+    }
+
+    rebuildRollups(fleet.trucks, fleet.rollups);
+    rebuildDispatch(fleet.trucks, fleet.dispatch);
+    rebuildSearchIndex(fleet.trucks, fleet.searchIndex);
+}
+
+void journalCommand(Fleet& fleet, const vector<string>& fields) {
+    if (!fleet.journal) return;
+    string line;
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (i > 0) line += '\t';
+        for (char c : fields[i]) line += (c == '\t' || c == '\n' || c == '\r') ? ' ' : c;
+    }
+    *fleet.journal << line << "\n";
+}
+
+// Writes the fleet loaded at startup as plain commands so a recorded
+// session replays from the same state without needing the data file.
+void journalSnapshot(Fleet& fleet) {
+    *fleet.journal << "# snapshot of " << fleet.trucks.size() << " truck(s) loaded at startup\n";
+    for (const auto& truck : fleet.trucks) {
+        vector<string> fields = { "add", truck.driverName, truck.licensePlate, truck.destination,
+                                  to_string(truck.emptyWeight), truck.timestamp };
+        for (const auto& box : truck.boxes) {
+            fields.push_back(to_string(box.weight));
+            fields.push_back(box.description);
+        }
+        journalCommand(fleet, fields);
+        if (find(begin(MANUAL_STATUSES), end(MANUAL_STATUSES), truck.status) != end(MANUAL_STATUSES)) {
+            journalCommand(fleet, { "status", to_string(truck.truckNumber), truck.status });
+        }
+    }
+    *fleet.journal << "# session\n";
+}
+
+vector<string> splitFields(const string& line) {
+    vector<string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == string::npos ? string::npos : tab - start));
+        if (tab == string::npos) break;
+        start = tab + 1;
+    }
+    return fields;
+}
+
+bool executeCommand(Fleet& fleet, const vector<string>& fields) {
+    const string& verb = fields[0];
+    size_t count = fields.size();
+
+    if (verb == "add" && count >= 6 && count % 2 == 0) {
+        vector<Box> boxes;
+        for (size_t i = 6; i + 1 < count; i += 2) boxes.push_back(Box(atoi(fields[i].c_str()), fields[i + 1]));
+        cmdAddTruck(fleet, fields[1], fields[2], fields[3], atoi(fields[4].c_str()), boxes, fields[5]);
+        return true;
+    }
+    if (verb == "status" && count == 3) return cmdUpdateStatus(fleet, atoi(fields[1].c_str()), fields[2]);
+    if (verb == "delete" && count == 2) return cmdDeleteTruck(fleet, atoi(fields[1].c_str()));
+    if (verb == "sort" && count == 2) return cmdSortTrucks(fleet, atoi(fields[1].c_str()));
+    if (verb == "search" && count == 4) {
+        for (int f = SEARCH_DRIVER; f <= SEARCH_STATUS; f++) {
+            if (fields[1] == SEARCH_FIELD_NAMES[f]) {
+                cmdSearch(fleet, (SearchField)f, fields[2], atoi(fields[3].c_str()));
+                return true;
+            }
+        }
+        return false;
+    }
+    if (verb == "dispatch" && count == 3) {
+        cmdDispatch(fleet, fields[2] == "*" ? "" : fields[2], atoi(fields[1].c_str()));
+        return true;
+    }
+    if (verb == "rollup" && count == 5) {
+        for (int g = ROLLUP_HOUR; g <= ROLLUP_WEEK; g++) {
+            if (fields[1] == ROLLUP_GRANULARITY_NAMES[g]) {
+                cmdRollupQuery(fleet, (RollupGranularity)g, fields[3] == "*" ? "" : fields[3],
+                               fields[4] == "*" ? "" : fields[4], atoi(fields[2].c_str()));
+                return true;
+            }
+        }
+        return false;
+    }
+    if (verb == "report" && count == 2) return cmdReport(fleet, fields[1]);
+    if (verb == "export" && count == 2) return cmdExport(fleet, fields[1]);
+    if (verb == "save" && count == 1) { cmdSave(fleet); return true; }
+    if (verb == "view" && count == 3) {
+        int page = atoi(fields[1].c_str());
+        cmdViewPage(fleet, page > 0 ? (size_t)page - 1 : 0, (size_t)max(1, atoi(fields[2].c_str())));
+        return true;
+    }
+    return false;
+}
+
+// Runs a session script against an empty fleet as fast as possible and
+// reports per-command latency percentiles. Saves, reports and exports all
+// go to REPLAY_PREFIX-named files, so the operator's data file, export
+// baseline and watermark are never touched.
+int runReplay(const string& path) {
+    ifstream script(path);
+    if (!script) { cerr << "Cannot open script: " << path << "\n"; return 1; }
+
+    Fleet fleet;
+    fleet.files = OutputFiles(REPLAY_PREFIX);
+    map<string, vector<long long>> latencies;
+    size_t lineNumber = 0, failures = 0;
+
+    NullBuffer sink;
+    streambuf* console = cout.rdbuf(&sink);
+    auto started = chrono::steady_clock::now();
+
+    string line;
+    while (getline(script, line)) {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (line.empty() || line[0] == '#') continue;
+
+        vector<string> fields = splitFields(line);
+        auto begin = chrono::steady_clock::now();
+        bool ok = executeCommand(fleet, fields);
+        auto end = chrono::steady_clock::now();
+
+        if (!ok) {
+            if (++failures <= 10) cerr << "Line " << lineNumber << ": cannot execute '" << fields[0] << "'\n";
+            continue;
+        }
+        latencies[fields[0]].push_back(chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+    }
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    cout.rdbuf(console);
+
+    size_t executed = 0;
+    for (const auto& entry : latencies) executed += entry.second.size();
+
+    cout << "\n\tTWMS REPLAY - " << path << "\n";
+    cout << "\tCommands: " << executed << " | Failed: " << failures
+         << " | Wall time: " << fixed << setprecision(3) << elapsed << " s"
+         << " | Final fleet: " << fleet.trucks.size() << " truck(s)\n";
+    cout << "\t" << string(96, '-') << "\n";
+    cout << "\t" << left << setw(12) << "Command" << right << setw(10) << "Count"
+         << setw(12) << "Mean" << setw(12) << "p50" << setw(12) << "p90"
+         << setw(12) << "p99" << setw(12) << "p99.9" << setw(14) << "Max (us)" << "\n";
+    cout << "\t" << string(96, '-') << "\n";
+
+    for (auto& entry : latencies) {
+        vector<long long>& samples = entry.second;
+        sort(samples.begin(), samples.end());
+        long long total = 0;
+        for (long long sample : samples) total += sample;
+
+        auto percentile = [&samples](double p) {
+            size_t index = min(samples.size() - 1, (size_t)(p * samples.size()));
+            return samples[index] / 1000.0;
+        };
+
+        cout << "\t" << left << setw(12) << entry.first << right << setw(10) << samples.size()
+             << fixed << setprecision(1)
+             << setw(12) << (total / 1000.0 / samples.size())
+             << setw(12) << percentile(0.50) << setw(12) << percentile(0.90)
+             << setw(12) << percentile(0.99) << setw(12) << percentile(0.999)
+             << setw(14) << (samples.back() / 1000.0) << "\n";
+    }
+    cout << "\t" << string(96, '-') << "\n";
+
+    return failures == 0 ? 0 : 2;
+}
+
+// Writes a synthetic but realistic session: mostly adds, with searches
+// (some with typos), status changes, dispatches, page views, rollups and
+// occasional deletes, sorts, exports and saves. The same seed always
+// produces the same script.
+int generateScript(const string& path, int commands, unsigned seed) {
+    ofstream out(path);
+    if (!out || commands <= 0) { cerr << "Cannot write script: " << path << "\n"; return 1; }
+
+    const string firstNames[] = { "Ali", "Sara", "John", "Maria", "Omar", "Chen", "Fatima", "David", "Aisha", "Ivan" };
+    const string lastNames[] = { "Khan", "Smith", "Ahmed", "Garcia", "Lee", "Malik", "Brown", "Raza", "Novak", "Shah" };
+    const string destinations[] = { "Karachi", "Lahore", "Islamabad", "Multan", "Peshawar", "Quetta", "Faisalabad", "Sialkot" };
+    const string cargo[] = { "Rice", "Wheat", "Cotton", "Cement", "Steel", "Textiles", "Fruit", "Machinery" };
+
+    mt19937 rng(seed);
+    vector<string> plates, drivers;
+    int fleetSize = 0;
+    time_t clock = 1767254400;
+
+    out << "# generated by --generate, seed " << seed << "\n";
+    for (int i = 0; i < commands; i++) {
+        clock += 30 + rng() % 60;
+        int roll = rng() % 1000;
+
+        if (fleetSize == 0 || roll < 600) {
+            string driver = firstNames[rng() % 10] + " " + lastNames[rng() % 10];
+            string plate;
+            for (int c = 0; c < 3; c++) plate += (char)('A' + rng() % 26);
+            plate += "-" + to_string(1000 + rng() % 9000);
+
+            char stamp[32];
+            strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", gmtime(&clock));
+
+            out << "add\t" << driver << "\t" << plate << "\t" << destinations[rng() % 8]
+                << "\t" << (600 + rng() % 800) << "\t" << stamp;
+            int boxes = rng() % 9;
+            for (int b = 0; b < boxes; b++) out << "\t" << (20 + rng() % 230) << "\t" << cargo[rng() % 8];
+            out << "\n";
+
+            plates.push_back(plate);
+            drivers.push_back(driver);
+            fleetSize++;
+        } else if (roll < 680) {
+            bool byPlate = rng() % 2 == 0;
+            string term = byPlate ? plates[rng() % plates.size()] : drivers[rng() % drivers.size()];
+            if (rng() % 2 == 0) term[rng() % term.size()] = (char)('A' + rng() % 26);
+            out << "search\t" << (byPlate ? "plate" : "driver") << "\t" << term << "\t" << (rng() % 3) << "\n";
+        } else if (roll < 800) {
+            out << "status\t" << (1 + rng() % fleetSize) << "\t" << MANUAL_STATUSES[rng() % 4] << "\n";
+        } else if (roll < 840) {
+            out << "dispatch\t" << (1 + rng() % 5) << "\t" << (rng() % 2 ? "*" : destinations[rng() % 8]) << "\n";
+        } else if (roll < 900) {
+            out << "view\t" << (1 + rng() % (fleetSize / 20 + 1)) << "\t20\n";
+        } else if (roll < 930) {
+            out << "rollup\t" << ROLLUP_GRANULARITY_NAMES[rng() % 3] << "\t" << (1 + rng() % 3) << "\t*\t*\n";
+        } else if (roll < 932) {
+            out << "delete\t" << (1 + rng() % fleetSize) << "\n";
+            fleetSize--;
+        } else if (roll < 933 && rng() % 10 == 0) {
+            out << "sort\t" << (1 + rng() % 4) << "\n";
+        } else if (roll < 940) {
+            out << "export\tincremental\n";
+        } else if (roll < 945) {
+            out << "report\tdelta\n";
+        } else if (roll < 946) {
+            out << "save\n";
+        } else {
+            out << "search\tdestination\t" << destinations[rng() % 8] << "\t0\n";
+        }
+    }
+
+    cout << "Generated " << commands << " command(s) into " << path << "\n";
+    return 0;
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage:\n"
+         << "  " << program << "                               interactive session\n"
+         << "  " << program << " --record <script>             interactive session, journaling every command\n"
+         << "  " << program << " --replay <script>             replay a script and report latency percentiles\n"
+         << "  " << program << " --generate <script> <n> [seed] write a synthetic script of n commands\n";
+}